@@ -0,0 +1,108 @@
+/*
+ * arena.c - Alocador por região (arena)
+ * -------------------------------------
+ * Cada bloco guarda seu tamanho e quanto já foi usado; alocar é avançar
+ * 'used'. Quando o bloco atual não comporta o pedido, um novo bloco é
+ * encadeado na frente. Não há liberação individual.
+ *
+ * NOTA: Todas as funções auxiliares são marcadas como 'static'
+ * para evitar conflitos com outros módulos.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "arena.h"
+
+/* ============================================================================
+ * ESTRUTURAS E FUNÇÕES AUXILIARES (STATIC - locais ao arquivo)
+ * ============================================================================ */
+
+#define ARENA_ALIGN 16
+
+struct ArenaBlock {
+    ArenaBlock* next;       /* Bloco anterior */
+    size_t size;            /* Bytes de dados do bloco */
+    size_t used;            /* Bytes já entregues */
+};
+
+/* Início dos dados (logo após o cabeçalho, já alinhado) */
+#define BLOCK_HEADER (((sizeof(ArenaBlock) + ARENA_ALIGN - 1) / ARENA_ALIGN) * ARENA_ALIGN)
+
+static unsigned char* block_data(ArenaBlock* b) {
+    return (unsigned char*)b + BLOCK_HEADER;
+}
+
+static size_t align_up(size_t n) {
+    return (n + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1);
+}
+
+/**
+ * Aloca um bloco com pelo menos 'size' bytes de dados
+ */
+static ArenaBlock* new_block(size_t size) {
+    ArenaBlock* b = malloc(BLOCK_HEADER + size);
+    if (!b) return NULL;
+    b->next = NULL;
+    b->size = size;
+    b->used = 0;
+    return b;
+}
+
+/* ============================================================================
+ * FUNÇÕES PÚBLICAS
+ * ============================================================================ */
+
+void arena_init(Arena* a, size_t block_size) {
+    a->head = NULL;
+    a->block_size = (block_size > 0) ? align_up(block_size) : 4096;
+}
+
+void arena_free(Arena* a) {
+    ArenaBlock* b = a->head;
+    while (b) {
+        ArenaBlock* next = b->next;
+        free(b);
+        b = next;
+    }
+    a->head = NULL;
+}
+
+void arena_reset(Arena* a) {
+    if (!a->head) return;
+
+    if (!a->head->next) {
+        a->head->used = 0;
+        return;
+    }
+
+    /* Vários blocos: juntar em um único do tamanho total */
+    size_t total = 0;
+    for (ArenaBlock* b = a->head; b; b = b->next) {
+        total += b->size;
+    }
+    arena_free(a);
+    a->head = new_block(total);
+}
+
+void* arena_alloc(Arena* a, size_t size) {
+    size = align_up(size > 0 ? size : 1);
+
+    ArenaBlock* b = a->head;
+    if (!b || b->size - b->used < size) {
+        size_t block_size = (size > a->block_size) ? size : a->block_size;
+        b = new_block(block_size);
+        if (!b) return NULL;
+        b->next = a->head;
+        a->head = b;
+    }
+
+    void* p = block_data(b) + b->used;
+    b->used += size;
+    return p;
+}
+
+void* arena_calloc(Arena* a, size_t count, size_t size) {
+    void* p = arena_alloc(a, count * size);
+    if (p) memset(p, 0, count * size);
+    return p;
+}
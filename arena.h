@@ -0,0 +1,39 @@
+/*
+ * arena.h - Alocador por região (arena)
+ *
+ * Alocações de mesma duração saem de blocos grandes por incremento de
+ * ponteiro e são liberadas todas de uma vez. Usado para a memória que vive
+ * tanto quanto o simulador e para as matrizes temporárias dos renderizadores,
+ * que zeram a arena a cada quadro em vez de liberar cada linha.
+ */
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>
+
+typedef struct ArenaBlock ArenaBlock;
+
+typedef struct {
+    ArenaBlock* head;       /* Bloco atual (os anteriores ficam encadeados) */
+    size_t block_size;      /* Tamanho mínimo de cada novo bloco */
+} Arena;
+
+/* Inicializa uma arena vazia (nenhuma memória é alocada ainda) */
+void arena_init(Arena* a, size_t block_size);
+
+/* Libera todos os blocos da arena */
+void arena_free(Arena* a);
+
+/* Descarta todas as alocações mantendo a memória para reuso.
+ * Se a arena usou vários blocos, eles são trocados por um só do tamanho
+ * total, de modo que o próximo uso do mesmo tamanho não aloca nada. */
+void arena_reset(Arena* a);
+
+/* Aloca size bytes alinhados (NULL se faltar memória) */
+void* arena_alloc(Arena* a, size_t size);
+
+/* Aloca count * size bytes zerados */
+void* arena_calloc(Arena* a, size_t count, size_t size);
+
+#endif /* ARENA_H */
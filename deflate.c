@@ -0,0 +1,285 @@
+/*
+ * deflate.c - Compressor deflate/zlib mínimo (sem dependências)
+ * --------------------------------------------------------------
+ * Tudo sai em um único bloco de Huffman fixo, fechado por um bloco final
+ * vazio. A busca de repetições é gulosa: para cada posição, percorre até
+ * MAX_CHAIN candidatas com o mesmo hash dos próximos 3 bytes e fica com a
+ * mais longa. A janela tem 2 x 32 KB; quando enche, a metade mais antiga
+ * é descartada e as posições guardadas no hash são deslocadas.
+ *
+ * NOTA: Todas as funções auxiliares são marcadas como 'static'
+ * para evitar conflitos com outros módulos.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "deflate.h"
+
+/* ============================================================================
+ * CONSTANTES E TABELAS (STATIC - locais ao arquivo)
+ * ============================================================================ */
+
+#define WSIZE           32768
+#define WMASK           (WSIZE - 1)
+#define HASH_BITS       15
+#define HASH_SIZE       (1 << HASH_BITS)
+#define MIN_MATCH       3
+#define MAX_MATCH       258
+#define MIN_LOOKAHEAD   (MAX_MATCH + MIN_MATCH + 1)
+#define MAX_CHAIN       64
+#define LONG_MATCH      32
+#define ADLER_MOD       65521
+
+/* Comprimentos: base e bits extras dos códigos 257..285 */
+static const int length_base[29] = {
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+    35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+};
+static const int length_extra[29] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+    3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+};
+
+/* Distâncias: base e bits extras dos códigos 0..29 */
+static const int dist_base[30] = {
+    1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+    257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145,
+    8193, 12289, 16385, 24577
+};
+static const int dist_extra[30] = {
+    0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+    7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13
+};
+
+/* ============================================================================
+ * SAÍDA DE BITS (STATIC)
+ * ============================================================================ */
+
+static void out_byte(Deflate* d, uint8_t byte) {
+    d->out[d->out_len++] = byte;
+    if (d->out_len == DEFLATE_OUT_CHUNK) {
+        d->out_fn(d->out_ctx, d->out, d->out_len);
+        d->out_len = 0;
+    }
+}
+
+/**
+ * Grava n bits (n <= 16), do menos significativo para o mais significativo
+ */
+static void put_bits(Deflate* d, uint32_t value, int n) {
+    d->bit_buffer |= value << d->bit_count;
+    d->bit_count += n;
+    while (d->bit_count >= 8) {
+        out_byte(d, d->bit_buffer & 0xFF);
+        d->bit_buffer >>= 8;
+        d->bit_count -= 8;
+    }
+}
+
+/**
+ * Grava um código de Huffman (que vai do bit mais significativo para o menos)
+ */
+static void put_code(Deflate* d, uint32_t code, int n) {
+    uint32_t reversed = 0;
+    for (int i = 0; i < n; i++) {
+        reversed = (reversed << 1) | ((code >> i) & 1);
+    }
+    put_bits(d, reversed, n);
+}
+
+/**
+ * Grava um símbolo literal/comprimento com a tabela de Huffman fixa
+ */
+static void put_symbol(Deflate* d, int sym) {
+    if (sym < 144) put_code(d, 0x30 + sym, 8);
+    else if (sym < 256) put_code(d, 0x190 + sym - 144, 9);
+    else if (sym < 280) put_code(d, sym - 256, 7);
+    else put_code(d, 0xC0 + sym - 280, 8);
+}
+
+/**
+ * Grava uma repetição (comprimento, distância)
+ */
+static void put_match(Deflate* d, int length, int dist) {
+    int lc = 28;
+    while (length_base[lc] > length) lc--;
+    put_symbol(d, 257 + lc);
+    put_bits(d, length - length_base[lc], length_extra[lc]);
+
+    int dc = 29;
+    while (dist_base[dc] > dist) dc--;
+    put_code(d, dc, 5);
+    put_bits(d, dist - dist_base[dc], dist_extra[dc]);
+}
+
+/* ============================================================================
+ * LZ77 (STATIC)
+ * ============================================================================ */
+
+static unsigned hash3(const uint8_t* p) {
+    return ((p[0] << 10) ^ (p[1] << 5) ^ p[2]) & (HASH_SIZE - 1);
+}
+
+/**
+ * Registra a posição pos na cadeia do seu hash
+ */
+static void insert_position(Deflate* d, size_t pos) {
+    if (d->window_len - pos < MIN_MATCH) return;
+
+    unsigned h = hash3(d->window + pos);
+    d->prev[pos & WMASK] = d->head[h];
+    d->head[h] = (int)pos + 1;
+}
+
+/**
+ * Descarta a metade mais antiga da janela
+ */
+static void slide_window(Deflate* d) {
+    memmove(d->window, d->window + WSIZE, d->window_len - WSIZE);
+    d->window_len -= WSIZE;
+    d->pos -= WSIZE;
+
+    for (int i = 0; i < HASH_SIZE; i++) {
+        d->head[i] = (d->head[i] > WSIZE) ? d->head[i] - WSIZE : 0;
+    }
+    for (int i = 0; i < WSIZE; i++) {
+        d->prev[i] = (d->prev[i] > WSIZE) ? d->prev[i] - WSIZE : 0;
+    }
+}
+
+/**
+ * Comprime a janela até restarem MIN_LOOKAHEAD bytes (ou tudo, se flush)
+ */
+static void compress_window(Deflate* d, int flush) {
+    size_t keep = flush ? 0 : MIN_LOOKAHEAD;
+
+    while (d->window_len - d->pos > keep) {
+        size_t pos = d->pos;
+        size_t avail = d->window_len - pos;
+        size_t max_len = (avail < MAX_MATCH) ? avail : MAX_MATCH;
+        size_t best_len = 0;
+        size_t best_dist = 0;
+
+        if (avail >= MIN_MATCH) {
+            int cand = d->head[hash3(d->window + pos)];
+            for (int chain = 0; cand > 0 && chain < MAX_CHAIN; chain++) {
+                size_t c = (size_t)cand - 1;
+                if (pos - c > WSIZE) break;
+
+                size_t len = 0;
+                while (len < max_len && d->window[c + len] == d->window[pos + len]) len++;
+                if (len > best_len) {
+                    best_len = len;
+                    best_dist = pos - c;
+                    if (len == max_len) break;
+                }
+                cand = d->prev[c & WMASK];
+            }
+        }
+
+        if (best_len >= MIN_MATCH) {
+            put_match(d, (int)best_len, (int)best_dist);
+            /* Repetições longas (áreas lisas): registrar só o início e o
+             * fim já basta para achar a continuação */
+            if (best_len <= LONG_MATCH) {
+                for (size_t i = 0; i < best_len; i++) insert_position(d, pos + i);
+            } else {
+                insert_position(d, pos);
+                for (size_t i = best_len - MIN_MATCH; i < best_len; i++) insert_position(d, pos + i);
+            }
+            d->pos += best_len;
+        } else {
+            put_symbol(d, d->window[pos]);
+            insert_position(d, pos);
+            d->pos++;
+        }
+    }
+}
+
+/* ============================================================================
+ * FUNÇÕES PÚBLICAS
+ * ============================================================================ */
+
+int deflate_init(Deflate* d, DeflateOutFn out_fn, void* out_ctx) {
+    memset(d, 0, sizeof(Deflate));
+    d->window = malloc(2 * WSIZE);
+    d->head = calloc(HASH_SIZE, sizeof(int));
+    d->prev = calloc(WSIZE, sizeof(int));
+    d->out = malloc(DEFLATE_OUT_CHUNK);
+    if (!d->window || !d->head || !d->prev || !d->out) {
+        deflate_free(d);
+        return 0;
+    }
+
+    d->adler_a = 1;
+    d->out_fn = out_fn;
+    d->out_ctx = out_ctx;
+
+    /* Cabeçalho zlib: deflate com janela de 32 KB, sem dicionário */
+    out_byte(d, 0x78);
+    out_byte(d, 0x01);
+
+    /* Início do bloco de Huffman fixo (não final) */
+    put_bits(d, 0, 1);
+    put_bits(d, 1, 2);
+    return 1;
+}
+
+void deflate_write(Deflate* d, const void* data, size_t size) {
+    const uint8_t* p = (const uint8_t*)data;
+
+    /* Adler-32 em trechos curtos o bastante para não estourar 32 bits */
+    for (size_t done = 0; done < size; ) {
+        size_t n = (size - done < 5552) ? size - done : 5552;
+        for (size_t i = 0; i < n; i++) {
+            d->adler_a += p[done + i];
+            d->adler_b += d->adler_a;
+        }
+        d->adler_a %= ADLER_MOD;
+        d->adler_b %= ADLER_MOD;
+        done += n;
+    }
+
+    while (size > 0) {
+        if (d->window_len == 2 * WSIZE) slide_window(d);
+
+        size_t n = 2 * WSIZE - d->window_len;
+        if (n > size) n = size;
+        memcpy(d->window + d->window_len, p, n);
+        d->window_len += n;
+        p += n;
+        size -= n;
+
+        compress_window(d, 0);
+    }
+}
+
+void deflate_finish(Deflate* d) {
+    compress_window(d, 1);
+
+    /* Fim do bloco atual e bloco final vazio */
+    put_symbol(d, 256);
+    put_bits(d, 1, 1);
+    put_bits(d, 1, 2);
+    put_symbol(d, 256);
+    if (d->bit_count > 0) put_bits(d, 0, 8 - d->bit_count);
+
+    /* Adler-32 (big-endian) */
+    uint32_t adler = (d->adler_b << 16) | d->adler_a;
+    for (int shift = 24; shift >= 0; shift -= 8) {
+        out_byte(d, (adler >> shift) & 0xFF);
+    }
+
+    if (d->out_len > 0) {
+        d->out_fn(d->out_ctx, d->out, d->out_len);
+        d->out_len = 0;
+    }
+}
+
+void deflate_free(Deflate* d) {
+    free(d->window);
+    free(d->head);
+    free(d->prev);
+    free(d->out);
+    memset(d, 0, sizeof(Deflate));
+}
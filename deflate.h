@@ -0,0 +1,55 @@
+/*
+ * deflate.h - Compressor deflate/zlib mínimo (sem dependências)
+ *
+ * Gera um fluxo zlib (RFC 1950) com blocos deflate de Huffman fixo
+ * (RFC 1951). As repetições são achadas por LZ77 com janela de 32 KB e
+ * tabela de hash. Não chega à taxa do zlib, mas imagens com grandes áreas
+ * de cor lisa (como o gráfico de Gantt) ficam dezenas de vezes menores.
+ * Usado pelo gravador de PNG.
+ *
+ * Os dados podem ser entregues aos poucos (deflate_write); a saída
+ * comprimida é repassada a uma função do usuário em pedaços de até
+ * DEFLATE_OUT_CHUNK bytes.
+ */
+
+#ifndef DEFLATE_H
+#define DEFLATE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define DEFLATE_OUT_CHUNK   65536
+
+/* Recebe um pedaço da saída comprimida */
+typedef void (*DeflateOutFn)(void* ctx, const uint8_t* data, size_t size);
+
+typedef struct {
+    uint8_t* window;        /* Janela deslizante (2 x 32 KB) */
+    size_t window_len;      /* Bytes válidos na janela */
+    size_t pos;             /* Próximo byte a comprimir */
+    int* head;              /* Última posição (+1) de cada hash */
+    int* prev;              /* Posição anterior (+1) com o mesmo hash */
+
+    uint32_t bit_buffer;    /* Bits ainda não gravados (LSB primeiro) */
+    int bit_count;
+    uint8_t* out;           /* Saída acumulada */
+    size_t out_len;
+
+    uint32_t adler_a, adler_b;  /* Adler-32 dos dados originais */
+    DeflateOutFn out_fn;
+    void* out_ctx;
+} Deflate;
+
+/* Prepara um fluxo novo (retorna 0 se faltar memória) */
+int deflate_init(Deflate* d, DeflateOutFn out_fn, void* out_ctx);
+
+/* Comprime mais size bytes */
+void deflate_write(Deflate* d, const void* data, size_t size);
+
+/* Comprime o que falta, fecha o fluxo e entrega a saída restante */
+void deflate_finish(Deflate* d);
+
+/* Libera a memória do compressor */
+void deflate_free(Deflate* d);
+
+#endif /* DEFLATE_H */
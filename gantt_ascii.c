@@ -8,47 +8,143 @@
  *  - Versão colorida com códigos ANSI
  *  - Versão simples para terminais sem suporte a cores
  *  - Exportação para arquivo texto
+ *
+ * Os desenhos saem direto da lista de execuções (GanttEntry), sem matriz
+ * tarefas x tempo: as entradas são agrupadas por linha (gantt_index) e
+ * cada linha é pintada só na janela pedida (GanttViewport), uma de cada
+ * vez. A memória é proporcional ao número de entradas mais a largura da
+ * janela, e toda a saída passa por um TextWriter.
  */
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include "gantt_ascii.h"
+#include "arena.h"
+#include "gantt_index.h"
+#include "text_writer.h"
 
 /* ============================================================================
  * CÓDIGOS DE CORES ANSI PARA TERMINAL
  * ============================================================================ */
 
 #define ANSI_RESET   "\033[0m"
-#define ANSI_RED     "\033[31m"
-#define ANSI_GREEN   "\033[32m"
 #define ANSI_YELLOW  "\033[33m"
-#define ANSI_BLUE    "\033[34m"
 #define ANSI_MAGENTA "\033[35m"
-#define ANSI_CYAN    "\033[36m"
-#define ANSI_WHITE   "\033[37m"
 #define ANSI_BOLD    "\033[1m"
 
+#define ASCII_DEFAULT_WIDTH 60      /* Colunas do gráfico colorido */
+#define ASCII_SIMPLE_WIDTH  50      /* Colunas do gráfico simples */
+
 /* ============================================================================
  * FUNÇÕES AUXILIARES (STATIC - locais ao arquivo)
  * ============================================================================ */
 
+/* Janela já resolvida: ticks [start, end), 'scale' ticks por coluna */
+typedef struct {
+    int start, end;
+    int scale;
+    int columns;
+} AsciiView;
+
+/**
+ * Ticks de uma linha dentro de [0, total_time)
+ */
+static int ascii_row_busy(const GanttIndex* index, const GanttEntry* entries, int row,
+                          int total_time) {
+    const GanttIndexRow* list = &index->rows[row];
+    int busy = 0;
+    for (int k = 0; k < list->count; k++) {
+        const GanttEntry* e = &entries[list->items[k]];
+        int end = (e->end_time < total_time) ? e->end_time : total_time;
+        if (end > e->start_time) busy += end - e->start_time;
+    }
+    return busy;
+}
+
+/**
+ * Pinta uma linha na janela: cells[c] fica 1 se alguma execução cobre a
+ * coluna c (0 = parada). Só as execuções que cruzam a janela são visitadas.
+ */
+static void ascii_paint_row(const GanttIndex* index, const GanttEntry* entries, int row,
+                            const AsciiView* view, char* cells) {
+    memset(cells, 0, view->columns);
+
+    const GanttIndexRow* list = &index->rows[row];
+    for (int k = gantt_index_row_lower(index, entries, row, view->start); k < list->count; k++) {
+        const GanttEntry* e = &entries[list->items[k]];
+        if (e->start_time >= view->end) break;
+
+        int start = (e->start_time > view->start) ? e->start_time : view->start;
+        int end = (e->end_time < view->end) ? e->end_time : view->end;
+        if (start >= end) continue;
+
+        int c_end = (end - 1 - view->start) / view->scale;
+        for (int c = (start - view->start) / view->scale; c <= c_end; c++) {
+            cells[c] = 1;
+        }
+    }
+}
+
+/**
+ * Resolve a janela pedida (NULL = primeiros 60 ticks, 1 tick por coluna).
+ * Retorna 0 se o início estiver além do fim da simulação.
+ */
+static int ascii_resolve_view(const GanttViewport* viewport, int total_time, AsciiView* view) {
+    int start = viewport ? viewport->start : 0;
+    int width = (viewport && viewport->width > 0) ? viewport->width : ASCII_DEFAULT_WIDTH;
+    int scale = viewport ? viewport->scale : 1;
+
+    if (start < 0) start = 0;
+    if (start >= total_time) return 0;
+
+    /* Escala 0: o suficiente para a janela chegar ao fim da simulação */
+    if (scale <= 0) {
+        long long span = total_time - start;
+        scale = (int)((span + width - 1) / width);
+        if (scale < 1) scale = 1;
+    }
+
+    long long end = start + (long long)width * scale;
+    view->start = start;
+    view->end = (end < total_time) ? (int)end : total_time;
+    view->scale = scale;
+    view->columns = (view->end - view->start + scale - 1) / scale;
+    return 1;
+}
+
 /**
- * Mapeia uma cor hexadecimal para código ANSI correspondente.
- * Usado para colorir a saída no terminal.
+ * Grava n cópias de um caractere
  */
-static const char* ascii_get_ansi_color(const char* hex) {
-    if (!hex) return ANSI_WHITE;
-
-    /* Verificar cores principais */
-    if (strstr(hex, "FF0000") || strstr(hex, "ff0000")) return ANSI_RED;
-    if (strstr(hex, "00FF00") || strstr(hex, "00ff00")) return ANSI_GREEN;
-    if (strstr(hex, "0000FF") || strstr(hex, "0000ff")) return ANSI_BLUE;
-    if (strstr(hex, "FFFF00") || strstr(hex, "ffff00")) return ANSI_YELLOW;
-    if (strstr(hex, "FF00FF") || strstr(hex, "ff00ff")) return ANSI_MAGENTA;
-    if (strstr(hex, "00FFFF") || strstr(hex, "00ffff")) return ANSI_CYAN;
-
-    return ANSI_WHITE;
+static void ascii_fill(TextWriter* w, char c, int n) {
+    char chunk[64];
+    memset(chunk, c, sizeof(chunk));
+    while (n > 0) {
+        int k = (n < (int)sizeof(chunk)) ? n : (int)sizeof(chunk);
+        tw_write(w, chunk, k);
+        n -= k;
+    }
+}
+
+/**
+ * Largura da coluna de rótulos ("T<id>" e dois espaços): pelo menos 6,
+ * mais se algum id tiver mais de 3 dígitos
+ */
+static int ascii_label_width(const GanttPalette* palette, int task_count) {
+    int width = 6;
+    for (int i = 0; i < task_count; i++) {
+        char label[16];
+        int len = snprintf(label, sizeof(label), "T%d  ", gantt_palette_label(palette, i));
+        if (len > width) width = len;
+    }
+    return width;
+}
+
+/**
+ * Grava n cópias de uma string (caracteres UTF-8 de mais de um byte)
+ */
+static void ascii_repeat(TextWriter* w, const char* s, int n) {
+    for (int i = 0; i < n; i++) tw_puts(w, s);
 }
 
 /* ============================================================================
@@ -62,131 +158,155 @@ static const char* ascii_get_ansi_color(const char* hex) {
  * @param entry_count  Número de entradas
  * @param total_time   Tempo total da simulação
  * @param task_count   Número de tarefas
+ * @param palette      Cores e rótulos das linhas
+ * @param viewport     Janela de tempo mostrada (NULL = primeiros 60 ticks)
  */
 void print_gantt_ascii(GanttEntry* entries, int entry_count,
-                       int total_time, int task_count) {
+                       int total_time, int task_count, const GanttPalette* palette,
+                       const GanttViewport* viewport) {
 
     if (task_count <= 0 || total_time <= 0) {
         printf("Erro: Dados inválidos para o Gantt Chart\n");
         return;
     }
 
-    /* Criar matriz de execução */
-    char** matrix = malloc(task_count * sizeof(char*));
-    char** colors = malloc(task_count * sizeof(char*));
-
-    if (!matrix || !colors) {
-        printf("Erro: Falha ao alocar memória\n");
+    AsciiView view;
+    if (!ascii_resolve_view(viewport, total_time, &view)) {
+        printf("Erro: Início da janela (%d) além do fim da simulação (%d ticks)\n",
+               viewport->start, total_time);
         return;
     }
 
-    for (int i = 0; i < task_count; i++) {
-        matrix[i] = calloc(total_time + 1, sizeof(char));
-        colors[i] = calloc(total_time * 10, sizeof(char));
-        if (matrix[i]) memset(matrix[i], ' ', total_time);
+    /* Índice por linha e uma linha de células (arena temporária) */
+    Arena scratch;
+    arena_init(&scratch, (size_t)view.columns + 64);
+
+    GanttIndex index;
+    gantt_index_init(&index);
+    char* cells = arena_alloc(&scratch, view.columns);
+    TextWriter out;
+    if (!cells || !gantt_index_build(&index, entries, entry_count, task_count) ||
+        !tw_attach(&out, stdout)) {
+        printf("Erro: Falha ao alocar memória\n");
+        gantt_index_free(&index);
+        arena_free(&scratch);
+        return;
     }
 
-    /* Preencher matriz com execuções */
-    for (int i = 0; i < entry_count; i++) {
-        if (entries[i].task_id >= 0 && entries[i].task_id < task_count) {
-            for (int t = entries[i].start_time; t < entries[i].end_time && t < total_time; t++) {
-                matrix[entries[i].task_id][t] = '#';
-                strncpy(&colors[entries[i].task_id][t * 10], entries[i].color, 7);
-            }
-        }
+    /* Overhead de troca de contexto (linha extra "CS") */
+    const GanttIndexRow* cs_row = &index.rows[task_count];
+    int overhead_time = 0;
+    for (int k = 0; k < cs_row->count; k++) {
+        const GanttEntry* e = &entries[cs_row->items[k]];
+        overhead_time += e->end_time - e->start_time;
     }
+    int run_entries = entry_count - cs_row->count;
+    int label_width = ascii_label_width(palette, task_count);
 
     /* Cabeçalho */
-    printf("\n");
-    printf("             " ANSI_BOLD "GANTT CHART - SIMULAÇÃO DE ESCALONAMENTO" ANSI_RESET "              \n");
-    printf("\n");
-
-    /* Limitar exibição a 60 ticks */
-    int display_time = (total_time < 60) ? total_time : 60;
-
-    /* Escala de tempo (primeira linha - dezenas) */
-    printf("      ");
-    for (int t = 0; t < display_time; t++) {
-        if (t % 10 == 0) {
-            printf("%2d        ", t);
-        }
+    tw_puts(&out, "\n");
+    tw_puts(&out, "             " ANSI_BOLD "GANTT CHART - SIMULAÇÃO DE ESCALONAMENTO" ANSI_RESET "              \n");
+    tw_puts(&out, "\n");
+
+    /* Escala de tempo (primeira linha - um rótulo a cada 10 colunas) */
+    ascii_fill(&out, ' ', label_width);
+    for (int c = 0; c < view.columns; c += 10) {
+        char label[16];
+        int len = snprintf(label, sizeof(label), "%2d", view.start + c * view.scale);
+        tw_write(&out, label, len);
+        ascii_fill(&out, ' ', 10 - len);
     }
-    printf("\n");
+    tw_putc(&out, '\n');
 
-    /* Escala de tempo (segunda linha - unidades) */
-    printf("Time  ");
-    for (int t = 0; t < display_time; t++) {
-        printf("%d", t % 10);
+    /* Escala de tempo (segunda linha - unidades, ou marcas se agrupado) */
+    tw_printf(&out, "%-*s", label_width, "Time");
+    for (int c = 0; c < view.columns; c++) {
+        if (view.scale == 1) tw_putc(&out, '0' + (view.start + c) % 10);
+        else tw_putc(&out, (c % 10 == 0) ? '|' : '.');
     }
-    printf("\n");
+    tw_putc(&out, '\n');
 
     /* Linha divisória */
-    printf("      ");
-    for (int t = 0; t < display_time; t++) {
-        printf("─");
-    }
-    printf("\n");
+    ascii_fill(&out, ' ', label_width);
+    ascii_repeat(&out, "─", view.columns);
+    tw_putc(&out, '\n');
 
     /* Tarefas */
     for (int i = 0; i < task_count; i++) {
-        printf("T%-3d  ", i);
-
-        for (int t = 0; t < display_time; t++) {
-            if (matrix[i][t] == '#') {
-                const char* color = ascii_get_ansi_color(&colors[i][t * 10]);
-                printf("%s█" ANSI_RESET, color);
+        tw_printf(&out, "T%-*d", label_width - 1, gantt_palette_label(palette, i));
+
+        const char* ansi = gantt_palette_color(palette, i)->ansi;
+        ascii_paint_row(&index, entries, i, &view, cells);
+        for (int c = 0; c < view.columns; c++) {
+            if (cells[c]) {
+                tw_puts(&out, ansi);
+                tw_puts(&out, "█" ANSI_RESET);
             } else {
-                printf("·");
+                tw_puts(&out, "·");
             }
         }
 
         /* Mostrar tempo de execução total */
-        int exec_time = 0;
-        for (int t = 0; t < total_time; t++) {
-            if (matrix[i][t] == '#') exec_time++;
+        tw_printf(&out, "  [%2d ticks]", ascii_row_busy(&index, entries, i, total_time));
+        tw_putc(&out, '\n');
+    }
+
+    if (overhead_time > 0) {
+        tw_printf(&out, "%-*s", label_width, "CS");
+        ascii_paint_row(&index, entries, task_count, &view, cells);
+        for (int c = 0; c < view.columns; c++) {
+            tw_puts(&out, cells[c] ? ANSI_MAGENTA "▒" ANSI_RESET : "·");
         }
-        printf("  [%2d ticks]", exec_time);
-        printf("\n");
+        tw_printf(&out, "  [%2d ticks]\n", overhead_time);
     }
 
     /* Linha divisória */
-    printf("      ");
-    for (int t = 0; t < display_time; t++) {
-        printf("─");
-    }
-    printf("\n");
+    ascii_fill(&out, ' ', label_width);
+    ascii_repeat(&out, "─", view.columns);
+    tw_putc(&out, '\n');
 
     /* Legenda */
-    printf("\n" ANSI_BOLD "Legenda:" ANSI_RESET "\n");
-    printf("  █ = Tarefa em execução\n");
-    printf("  · = Tarefa não executando\n");
+    tw_puts(&out, "\n" ANSI_BOLD "Legenda:" ANSI_RESET "\n");
+    tw_puts(&out, "  █ = Tarefa em execução\n");
+    tw_puts(&out, "  · = Tarefa não executando\n");
+    if (overhead_time > 0) {
+        tw_puts(&out, "  ▒ = Overhead de troca de contexto\n");
+    }
 
-    if (total_time > 60) {
-        printf("\n" ANSI_YELLOW "Nota: Mostrando apenas os primeiros 60 ticks" ANSI_RESET "\n");
+    if (view.start == 0 && view.scale == 1 && view.end < total_time) {
+        tw_printf(&out, "\n" ANSI_YELLOW "Nota: Mostrando apenas os primeiros %d ticks" ANSI_RESET "\n",
+                  view.end);
+    } else if (view.start > 0 || view.end < total_time || view.scale > 1) {
+        tw_printf(&out, "\n" ANSI_YELLOW "Nota: Mostrando os ticks %d a %d de %d",
+                  view.start, view.end - 1, total_time);
+        if (view.scale > 1) tw_printf(&out, " (%d ticks por coluna)", view.scale);
+        tw_puts(&out, ANSI_RESET "\n");
     }
 
     /* Estatísticas do Gantt */
-    printf("\n" ANSI_BOLD "Estatísticas do Gantt:" ANSI_RESET "\n");
+    tw_puts(&out, "\n" ANSI_BOLD "Estatísticas do Gantt:" ANSI_RESET "\n");
 
     int total_exec = 0;
     for (int i = 0; i < entry_count; i++) {
         total_exec += (entries[i].end_time - entries[i].start_time);
     }
+    total_exec -= overhead_time;
 
     float cpu_usage = (total_time > 0) ? (float)total_exec / total_time * 100 : 0;
-    printf("  Tempo total: %d ticks\n", total_time);
-    printf("  Tempo de CPU usado: %d ticks\n", total_exec);
-    printf("  Utilização da CPU: %.1f%%\n", cpu_usage);
-    printf("  Número de tarefas: %d\n", task_count);
-    printf("  Trocas de contexto: %d\n", (entry_count > 0) ? entry_count - 1 : 0);
+    tw_printf(&out, "  Tempo total: %d ticks\n", total_time);
+    tw_printf(&out, "  Tempo de CPU usado: %d ticks\n", total_exec);
+    tw_printf(&out, "  Utilização da CPU: %.1f%%\n", cpu_usage);
+    tw_printf(&out, "  Número de tarefas: %d\n", task_count);
+    tw_printf(&out, "  Trocas de contexto: %d\n", (run_entries > 0) ? run_entries - 1 : 0);
+    if (overhead_time > 0) {
+        tw_printf(&out, "  Overhead de troca: %d ticks (%.1f%%)\n", overhead_time,
+                  (float)overhead_time / total_time * 100);
+    }
 
     /* Limpar memória */
-    for (int i = 0; i < task_count; i++) {
-        free(matrix[i]);
-        free(colors[i]);
-    }
-    free(matrix);
-    free(colors);
+    tw_close(&out);
+    gantt_index_free(&index);
+    arena_free(&scratch);
 }
 
 /**
@@ -194,7 +314,7 @@ void print_gantt_ascii(GanttEntry* entries, int entry_count,
  * Compatível com todos os terminais.
  */
 void print_gantt_simple(GanttEntry* entries, int entry_count,
-                       int total_time, int task_count) {
+                       int total_time, int task_count, const GanttPalette* palette) {
 
     printf("\n=== GANTT CHART (ASCII) ===\n\n");
 
@@ -203,48 +323,46 @@ void print_gantt_simple(GanttEntry* entries, int entry_count,
         return;
     }
 
-    /* Criar matriz */
-    char** matrix = malloc(task_count * sizeof(char*));
-    if (!matrix) return;
-
-    for (int i = 0; i < task_count; i++) {
-        matrix[i] = calloc(total_time + 1, sizeof(char));
-        if (matrix[i]) memset(matrix[i], '.', total_time);
-    }
-
-    /* Preencher */
-    for (int i = 0; i < entry_count; i++) {
-        if (entries[i].task_id >= 0 && entries[i].task_id < task_count) {
-            for (int t = entries[i].start_time; t < entries[i].end_time && t < total_time; t++) {
-                matrix[entries[i].task_id][t] = '#';
-            }
-        }
-    }
-
     /* Limitar exibição */
-    int display_time = (total_time < 50) ? total_time : 50;
+    GanttViewport viewport = {0, ASCII_SIMPLE_WIDTH, 1};
+    AsciiView view;
+    ascii_resolve_view(&viewport, total_time, &view);
+
+    Arena scratch;
+    arena_init(&scratch, (size_t)view.columns + 64);
+
+    GanttIndex index;
+    gantt_index_init(&index);
+    char* cells = arena_alloc(&scratch, view.columns);
+    TextWriter out;
+    if (!cells || !gantt_index_build(&index, entries, entry_count, task_count) ||
+        !tw_attach(&out, stdout)) {
+        gantt_index_free(&index);
+        arena_free(&scratch);
+        return;
+    }
 
     /* Imprimir tempo */
-    printf("     ");
-    for (int t = 0; t < display_time; t += 5) {
-        printf("%-5d", t);
+    tw_puts(&out, "     ");
+    for (int t = 0; t < view.columns; t += 5) {
+        tw_printf(&out, "%-5d", t);
     }
-    printf("\n");
+    tw_putc(&out, '\n');
 
     /* Imprimir tarefas */
     for (int i = 0; i < task_count; i++) {
-        printf("T%2d: ", i);
-        for (int t = 0; t < display_time; t++) {
-            printf("%c", matrix[i][t]);
+        tw_printf(&out, "T%2d: ", gantt_palette_label(palette, i));
+        ascii_paint_row(&index, entries, i, &view, cells);
+        for (int c = 0; c < view.columns; c++) {
+            tw_putc(&out, cells[c] ? '#' : '.');
         }
-        printf("\n");
+        tw_putc(&out, '\n');
     }
 
     /* Limpar */
-    for (int i = 0; i < task_count; i++) {
-        free(matrix[i]);
-    }
-    free(matrix);
+    tw_close(&out);
+    gantt_index_free(&index);
+    arena_free(&scratch);
 }
 
 /**
@@ -255,77 +373,86 @@ void print_gantt_simple(GanttEntry* entries, int entry_count,
  * @param entry_count  Número de entradas
  * @param total_time   Tempo total da simulação
  * @param task_count   Número de tarefas
+ * @param palette      Rótulos das linhas
  */
 void save_gantt_text(const char* filename, GanttEntry* entries, int entry_count,
-                    int total_time, int task_count) {
+                    int total_time, int task_count, const GanttPalette* palette) {
 
-    FILE* f = fopen(filename, "w");
-    if (!f) {
+    TextWriter out;
+    if (!tw_open(&out, filename)) {
         printf("Erro: Não foi possível criar o arquivo %s\n", filename);
         return;
     }
 
-    fprintf(f, "GANTT CHART - RELATÓRIO DE EXECUÇÃO\n");
-    fprintf(f, "=====================================\n\n");
+    tw_puts(&out, "GANTT CHART - RELATÓRIO DE EXECUÇÃO\n");
+    tw_puts(&out, "=====================================\n\n");
 
-    /* Criar matriz */
-    char** matrix = malloc(task_count * sizeof(char*));
-    if (!matrix) {
-        fclose(f);
+    /* Agrupar as execuções por tarefa */
+    GanttIndex index;
+    gantt_index_init(&index);
+    if (task_count < 0 || !gantt_index_build(&index, entries, entry_count, task_count)) {
+        gantt_index_free(&index);
+        tw_close(&out);
         return;
     }
 
-    for (int i = 0; i < task_count; i++) {
-        matrix[i] = calloc(total_time + 1, sizeof(char));
-        if (matrix[i]) memset(matrix[i], ' ', total_time);
-    }
-
-    /* Preencher */
-    for (int i = 0; i < entry_count; i++) {
-        if (entries[i].task_id >= 0 && entries[i].task_id < task_count) {
-            for (int t = entries[i].start_time; t < entries[i].end_time && t < total_time; t++) {
-                matrix[entries[i].task_id][t] = '*';
-            }
-        }
-    }
-
     /* Escrever escala de tempo */
-    fprintf(f, "Time: ");
+    tw_puts(&out, "Time: ");
     for (int t = 0; t < total_time; t++) {
-        fprintf(f, "%d", t % 10);
+        tw_putc(&out, '0' + t % 10);
     }
-    fprintf(f, "\n");
-
-    /* Escrever tarefas */
-    for (int i = 0; i < task_count; i++) {
-        fprintf(f, "T%02d:  ", i);
-        for (int t = 0; t < total_time; t++) {
-            fprintf(f, "%c", matrix[i][t]);
+    tw_putc(&out, '\n');
+
+    /* Escrever tarefas: trechos de espaços e '*' direto das execuções
+     * (a linha "CS" do overhead só aparece se houve trocas com custo) */
+    int rows = (index.rows[task_count].count > 0) ? task_count + 1 : task_count;
+    for (int i = 0; i < rows; i++) {
+        if (i < task_count) tw_printf(&out, "T%02d:  ", gantt_palette_label(palette, i));
+        else tw_puts(&out, "CS:   ");
+
+        const GanttIndexRow* list = &index.rows[i];
+        int pos = 0;
+        for (int k = 0; k < list->count; k++) {
+            const GanttEntry* e = &entries[list->items[k]];
+            int start = (e->start_time > pos) ? e->start_time : pos;
+            int end = (e->end_time < total_time) ? e->end_time : total_time;
+            if (start >= end) continue;
+
+            ascii_fill(&out, ' ', start - pos);
+            ascii_fill(&out, '*', end - start);
+            pos = end;
         }
-        fprintf(f, "\n");
+        ascii_fill(&out, ' ', total_time - pos);
+        tw_putc(&out, '\n');
     }
 
-    fprintf(f, "\n");
-    fprintf(f, "Legenda: * = executando, espaço = aguardando\n");
-    fprintf(f, "\n");
+    tw_putc(&out, '\n');
+    tw_puts(&out, "Legenda: * = executando, espaço = aguardando");
+    if (rows > task_count) tw_puts(&out, ", CS = troca de contexto");
+    tw_putc(&out, '\n');
+    tw_putc(&out, '\n');
 
     /* Detalhes de execução */
-    fprintf(f, "DETALHES DE EXECUÇÃO:\n");
-    fprintf(f, "---------------------\n");
+    tw_puts(&out, "DETALHES DE EXECUÇÃO:\n");
+    tw_puts(&out, "---------------------\n");
     for (int i = 0; i < entry_count; i++) {
-        fprintf(f, "Tarefa %d: tempo %d-%d (duração: %d)\n",
-                entries[i].task_id,
-                entries[i].start_time,
-                entries[i].end_time,
-                entries[i].end_time - entries[i].start_time);
+        if (entries[i].task_id == GANTT_OVERHEAD_ID) {
+            tw_puts(&out, "Troca de contexto: ");
+        } else {
+            tw_printf(&out, "Tarefa %d: ", gantt_palette_label(palette, entries[i].task_id));
+        }
+        tw_printf(&out, "tempo %d-%d (duração: %d)\n",
+                  entries[i].start_time,
+                  entries[i].end_time,
+                  entries[i].end_time - entries[i].start_time);
     }
 
     /* Limpar */
-    for (int i = 0; i < task_count; i++) {
-        free(matrix[i]);
-    }
-    free(matrix);
+    gantt_index_free(&index);
 
-    fclose(f);
+    if (!tw_close(&out)) {
+        printf("Erro: Falha ao gravar o arquivo %s\n", filename);
+        return;
+    }
     printf("Relatório salvo em: %s\n", filename);
-}
\ No newline at end of file
+}
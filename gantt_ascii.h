@@ -7,16 +7,27 @@
 
 #include "gantt_bmp.h"  /* Para usar GanttEntry */
 
-/* Imprime o Gantt Chart colorido no terminal (com cores ANSI) */
+/* Janela de tempo mostrada no terminal */
+typedef struct {
+    int start;          /* Primeiro tick mostrado */
+    int width;          /* Número de colunas (0 = padrão, 60) */
+    int scale;          /* Ticks por coluna; uma coluna fica cheia se a
+                         * tarefa executou em algum deles (0 = o bastante
+                         * para chegar ao fim da simulação) */
+} GanttViewport;
+
+/* Imprime o Gantt Chart colorido no terminal (com cores ANSI), só na janela
+ * pedida (NULL = primeiros 60 ticks, 1 tick por coluna) */
 void print_gantt_ascii(GanttEntry* entries, int entry_count,
-                       int total_time, int task_count);
+                       int total_time, int task_count, const GanttPalette* palette,
+                       const GanttViewport* viewport);
 
 /* Imprime o Gantt Chart simples (sem cores, compatível com todos os terminais) */
 void print_gantt_simple(GanttEntry* entries, int entry_count,
-                       int total_time, int task_count);
+                       int total_time, int task_count, const GanttPalette* palette);
 
 /* Salva o Gantt Chart em arquivo texto */
 void save_gantt_text(const char* filename, GanttEntry* entries, int entry_count,
-                    int total_time, int task_count);
+                    int total_time, int task_count, const GanttPalette* palette);
 
 #endif /* GANTT_ASCII_H */
\ No newline at end of file
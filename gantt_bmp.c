@@ -2,7 +2,8 @@
  * gantt_bmp.c - Gerador de Gráfico de Gantt em formato BMP
  * --------------------------------------------------------
  * Este módulo gera uma imagem BMP do diagrama de Gantt mostrando
- * a execução das tarefas ao longo do tempo.
+ * a execução das tarefas ao longo do tempo. A mesma imagem pode ser
+ * gravada como BMP de 8 bits com paleta, BMP comprimido (RLE8) ou PNG.
  *
  * Características:
  *  - Linhas horizontais separando cada tarefa
@@ -12,16 +13,28 @@
  *  - Barras coloridas indicando execução das tarefas
  *  - Fundo alternado para melhor legibilidade
  *  - Legenda na parte inferior
+ *  - Marcadores de prazo e linha do tempo de perdas de prazo (opcional)
+ *  - Linha "CS" com o overhead de troca de contexto (se houver)
+ *  - Nível de detalhe para linhas do tempo longas: com largura máxima, cada
+ *    coluna de pixels agrupa vários ticks e mostra a ocupação das tarefas
+ *  - Imagens grandes são rasterizadas por várias threads, cada uma em sua
+ *    faixa de linhas de pixels
  *
  * NOTA: Todas as funções auxiliares são marcadas como 'static'
  * para evitar conflitos com outros módulos.
  */
 
+#define _POSIX_C_SOURCE 200809L
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <stdint.h>
+#include <pthread.h>
+#include <unistd.h>
 #include "gantt_bmp.h"
+#include "deflate.h"
+#include "gantt_index.h"
 
 /* ============================================================================
  * ESTRUTURAS DO FORMATO BMP
@@ -75,6 +88,7 @@ typedef struct {
 #define ROW_SPACING     5       /* Espaço entre linhas */
 #define BAR_HEIGHT      30      /* Altura das barras de execução */
 #define MIN_TICK_WIDTH  15      /* Largura mínima por unidade de tempo */
+#define MISS_STRIP_HEIGHT 24    /* Altura da faixa de perdas de prazo */
 
 /* Cores predefinidas para elementos do gráfico */
 #define COLOR_BACKGROUND_R  255
@@ -93,24 +107,63 @@ typedef struct {
 #define COLOR_ALT_ROW_G     248
 #define COLOR_ALT_ROW_B     255
 
+#define COLOR_DEADLINE_R    150
+#define COLOR_DEADLINE_G    0
+#define COLOR_DEADLINE_B    0
+
+#define COLOR_MISS_R        230
+#define COLOR_MISS_G        0
+#define COLOR_MISS_B        0
+
+/* Eixo do tempo: converte ticks em coordenadas X.
+ * Sem nível de detalhe, cada tick ocupa time_scale pixels; com ele, a área
+ * do gráfico (chart_width pixels) é dividida proporcionalmente. */
+typedef struct {
+    int time_scale;             /* Pixels por tick (modo normal) */
+    int chart_width;            /* Largura da área do gráfico (modo LOD) */
+    int total_time;             /* Ticks representados */
+    int lod;                    /* 1 = ticks agrupados em colunas */
+} TimeAxis;
+
 /* ============================================================================
  * FUNÇÕES AUXILIARES (STATIC - locais ao arquivo)
  * ============================================================================ */
 
 /**
- * Converte uma string hexadecimal de cor para estrutura RGB
- * Aceita formatos: "#RRGGBB" ou "RRGGBB"
+ * Coordenada X do instante t
  */
-static BmpColor bmp_hex_to_rgb(const char* hex) {
-    BmpColor c = {0, 0, 0};
-    if (hex[0] == '#') hex++;  /* Pular o '#' se presente */
+static int axis_x(const TimeAxis* axis, long long t) {
+    if (!axis->lod) return MARGIN_LEFT + (int)(t * axis->time_scale);
+    return MARGIN_LEFT + (int)(t * axis->chart_width / axis->total_time);
+}
 
-    unsigned int value;
-    if (sscanf(hex, "%06x", &value) == 1) {
-        c.r = (value >> 16) & 0xFF;
-        c.g = (value >> 8) & 0xFF;
-        c.b = value & 0xFF;
+/**
+ * Intervalo "redondo" (1, 2 ou 5 vezes uma potência de 10) entre rótulos de
+ * tempo, de modo que fiquem a pelo menos min_px pixels um do outro
+ */
+static int bmp_label_interval(const TimeAxis* axis, int min_px) {
+    long long step = 1;
+    for (;;) {
+        static const int mult[3] = {1, 2, 5};
+        for (int i = 0; i < 3; i++) {
+            long long interval = step * mult[i];
+            if (interval * axis->chart_width >= (long long)min_px * axis->total_time ||
+                interval >= axis->total_time) {
+                return (int)interval;
+            }
+        }
+        step *= 10;
     }
+}
+
+/**
+ * Mistura duas cores: amount = 0.0 devolve 'base', 1.0 devolve 'top'
+ */
+static BmpColor bmp_blend_color(BmpColor base, BmpColor top, float amount) {
+    BmpColor c;
+    c.r = (uint8_t)(base.r + (top.r - base.r) * amount);
+    c.g = (uint8_t)(base.g + (top.g - base.g) * amount);
+    c.b = (uint8_t)(base.b + (top.b - base.b) * amount);
     return c;
 }
 
@@ -144,129 +197,163 @@ static const uint8_t digit_font[10][5] = {
     {0x7, 0x5, 0x7, 0x1, 0x7}  /* 9 */
 };
 
-/* Letra 'T' para rótulos de tarefas (3x5) */
+/* Letras usadas nos rótulos (3x5) */
 static const uint8_t letter_T[5] = {
     0x7, 0x2, 0x2, 0x2, 0x2
 };
 
+static const uint8_t letter_M[5] = {
+    0x5, 0x7, 0x7, 0x5, 0x5
+};
+
+static const uint8_t letter_I[5] = {
+    0x7, 0x2, 0x2, 0x2, 0x7
+};
+
+static const uint8_t letter_S[5] = {
+    0x7, 0x4, 0x7, 0x1, 0x7
+};
+
+static const uint8_t letter_C[5] = {
+    0x7, 0x4, 0x4, 0x4, 0x7
+};
+
 /* ============================================================================
  * FUNÇÕES DE DESENHO (STATIC)
  * ============================================================================ */
 
+/* Área de desenho: uma faixa de linhas [y0, y1) da imagem.
+ * As coordenadas são sempre as da imagem inteira; o que cai fora da faixa
+ * é descartado, então a mesma sequência de desenho produz qualquer faixa. */
+typedef struct {
+    uint8_t* data;              /* Pixels da faixa (BGR, row_size bytes por linha) */
+    int row_size;               /* Bytes por linha (com preenchimento) */
+    int width;                  /* Largura da imagem */
+    int height;                 /* Altura da imagem */
+    int y0, y1;                 /* Linhas da imagem presentes na faixa */
+} BmpCanvas;
+
 /**
- * Desenha um único pixel na imagem
+ * Recorta o retângulo [x1, x2] x [y1, y2] à faixa; retorna 0 se nada sobra
  */
-static void bmp_draw_pixel(uint8_t *image, int row_size, int width, int height,
-                           int px, int py, uint8_t r, uint8_t g, uint8_t b) {
-    if (px < 0 || px >= width || py < 0 || py >= height) return;
-
-    int idx = py * row_size + px * 3;
-    image[idx] = b;      /* BMP armazena em ordem BGR */
-    image[idx + 1] = g;
-    image[idx + 2] = r;
+static int bmp_clip_rect(const BmpCanvas* cv, int* x1, int* y1, int* x2, int* y2) {
+    if (*x1 < 0) *x1 = 0;
+    if (*x2 > cv->width - 1) *x2 = cv->width - 1;
+    if (*y1 < cv->y0) *y1 = cv->y0;
+    if (*y2 > cv->y1 - 1) *y2 = cv->y1 - 1;
+    return *x1 <= *x2 && *y1 <= *y2;
 }
 
 /**
- * Desenha uma linha horizontal
+ * Desenha um retângulo preenchido: a primeira linha do trecho recebe o
+ * padrão BGR (dobrando o trecho já preenchido a cada cópia) e as demais
+ * linhas são copiadas dela
  */
-static void bmp_draw_hline(uint8_t *image, int row_size, int width, int height,
-                           int x1, int x2, int y, BmpColor col) {
-    for (int x = x1; x <= x2 && x < width; x++) {
-        bmp_draw_pixel(image, row_size, width, height, x, y, col.r, col.g, col.b);
+static void bmp_draw_filled_rect(BmpCanvas* cv, int x1, int y1, int x2, int y2, BmpColor col) {
+    if (!bmp_clip_rect(cv, &x1, &y1, &x2, &y2)) return;
+
+    size_t span = (size_t)(x2 - x1 + 1) * 3;
+    uint8_t* first = cv->data + (size_t)(y1 - cv->y0) * cv->row_size + (size_t)x1 * 3;
+
+    first[0] = col.b;       /* BMP armazena em ordem BGR */
+    first[1] = col.g;
+    first[2] = col.r;
+    for (size_t done = 3; done < span; ) {
+        size_t n = (done < span - done) ? done : span - done;
+        memcpy(first + done, first, n);
+        done += n;
+    }
+
+    uint8_t* row = first;
+    for (int y = y1 + 1; y <= y2; y++) {
+        row += cv->row_size;
+        memcpy(row, first, span);
     }
 }
 
 /**
- * Desenha uma linha vertical
+ * Desenha uma linha horizontal
  */
-static void bmp_draw_vline(uint8_t *image, int row_size, int width, int height,
-                           int x, int y1, int y2, BmpColor col) {
-    for (int y = y1; y <= y2 && y < height; y++) {
-        bmp_draw_pixel(image, row_size, width, height, x, y, col.r, col.g, col.b);
-    }
+static void bmp_draw_hline(BmpCanvas* cv, int x1, int x2, int y, BmpColor col) {
+    bmp_draw_filled_rect(cv, x1, y, x2, y, col);
 }
 
 /**
- * Desenha um retângulo preenchido
+ * Desenha uma linha vertical
  */
-static void bmp_draw_filled_rect(uint8_t *image, int row_size, int width, int height,
-                                 int x1, int y1, int x2, int y2, BmpColor col) {
-    for (int y = y1; y <= y2 && y < height; y++) {
-        for (int x = x1; x <= x2 && x < width; x++) {
-            bmp_draw_pixel(image, row_size, width, height, x, y, col.r, col.g, col.b);
-        }
+static void bmp_draw_vline(BmpCanvas* cv, int x, int y1, int y2, BmpColor col) {
+    int x2 = x;
+    if (!bmp_clip_rect(cv, &x, &y1, &x2, &y2)) return;
+
+    uint8_t* p = cv->data + (size_t)(y1 - cv->y0) * cv->row_size + (size_t)x * 3;
+    for (int y = y1; y <= y2; y++) {
+        p[0] = col.b;
+        p[1] = col.g;
+        p[2] = col.r;
+        p += cv->row_size;
     }
 }
 
 /**
  * Desenha um retângulo com borda
  */
-static void bmp_draw_rect_bordered(uint8_t *image, int row_size, int width, int height,
-                                   int x1, int y1, int x2, int y2,
+static void bmp_draw_rect_bordered(BmpCanvas* cv, int x1, int y1, int x2, int y2,
                                    BmpColor fill, BmpColor border, int bw) {
     /* Desenhar preenchimento */
-    bmp_draw_filled_rect(image, row_size, width, height, x1, y1, x2, y2, fill);
+    bmp_draw_filled_rect(cv, x1, y1, x2, y2, fill);
 
     /* Desenhar bordas */
-    for (int b = 0; b < bw; b++) {
-        bmp_draw_hline(image, row_size, width, height, x1, x2, y1 + b, border);
-        bmp_draw_hline(image, row_size, width, height, x1, x2, y2 - b, border);
-        bmp_draw_vline(image, row_size, width, height, x1 + b, y1, y2, border);
-        bmp_draw_vline(image, row_size, width, height, x2 - b, y1, y2, border);
-    }
+    bmp_draw_filled_rect(cv, x1, y1, x2, y1 + bw - 1, border);
+    bmp_draw_filled_rect(cv, x1, y2 - bw + 1, x2, y2, border);
+    bmp_draw_filled_rect(cv, x1, y1, x1 + bw - 1, y2, border);
+    bmp_draw_filled_rect(cv, x2 - bw + 1, y1, x2, y2, border);
 }
 
+/* Trechos contínuos de cada linha de 3 bits de um glifo: {início, largura}.
+ * Cada linha do glifo vira no máximo dois retângulos em vez de um teste
+ * por bit e por pixel. */
+static const uint8_t glyph_row_runs[8][2][2] = {
+    {{0, 0}, {0, 0}},   /* ... */
+    {{2, 1}, {0, 0}},   /* ..# */
+    {{1, 1}, {0, 0}},   /* .#. */
+    {{1, 2}, {0, 0}},   /* .## */
+    {{0, 1}, {0, 0}},   /* #.. */
+    {{0, 1}, {2, 1}},   /* #.# */
+    {{0, 2}, {0, 0}},   /* ##. */
+    {{0, 3}, {0, 0}}    /* ### */
+};
+
 /**
- * Desenha um dígito individual
+ * Desenha uma letra a partir de seu bitmap 3x5
  */
-static void bmp_draw_digit(uint8_t *image, int row_size, int width, int height,
-                           int digit, int x0, int y0, int scale, BmpColor col) {
-    if (digit < 0 || digit > 9) return;
+static void bmp_draw_letter(BmpCanvas* cv, const uint8_t glyph[5], int x0, int y0,
+                            int scale, BmpColor col) {
+    /* Glifo inteiramente fora da faixa: nada a fazer */
+    if (y0 >= cv->y1 || y0 + 5 * scale <= cv->y0) return;
 
     for (int ry = 0; ry < 5; ry++) {
-        uint8_t row = digit_font[digit][ry];
-        for (int rx = 0; rx < 3; rx++) {
-            if (row & (1 << (2 - rx))) {
-                for (int sy = 0; sy < scale; sy++) {
-                    for (int sx = 0; sx < scale; sx++) {
-                        bmp_draw_pixel(image, row_size, width, height,
-                                       x0 + rx * scale + sx,
-                                       y0 + ry * scale + sy,
-                                       col.r, col.g, col.b);
-                    }
-                }
-            }
+        const uint8_t (*runs)[2] = glyph_row_runs[glyph[ry] & 0x7];
+        int y = y0 + ry * scale;
+
+        for (int k = 0; k < 2 && runs[k][1] > 0; k++) {
+            int x = x0 + runs[k][0] * scale;
+            bmp_draw_filled_rect(cv, x, y, x + runs[k][1] * scale - 1, y + scale - 1, col);
         }
     }
 }
 
 /**
- * Desenha a letra 'T'
+ * Desenha um dígito individual
  */
-static void bmp_draw_letter_T(uint8_t *image, int row_size, int width, int height,
-                              int x0, int y0, int scale, BmpColor col) {
-    for (int ry = 0; ry < 5; ry++) {
-        uint8_t row = letter_T[ry];
-        for (int rx = 0; rx < 3; rx++) {
-            if (row & (1 << (2 - rx))) {
-                for (int sy = 0; sy < scale; sy++) {
-                    for (int sx = 0; sx < scale; sx++) {
-                        bmp_draw_pixel(image, row_size, width, height,
-                                       x0 + rx * scale + sx,
-                                       y0 + ry * scale + sy,
-                                       col.r, col.g, col.b);
-                    }
-                }
-            }
-        }
-    }
+static void bmp_draw_digit(BmpCanvas* cv, int digit, int x0, int y0, int scale, BmpColor col) {
+    if (digit < 0 || digit > 9) return;
+    bmp_draw_letter(cv, digit_font[digit], x0, y0, scale, col);
 }
 
 /**
  * Desenha um número inteiro
  */
-static int bmp_draw_number(uint8_t *image, int row_size, int width, int height,
-                           int number, int x0, int y0, int scale, BmpColor col) {
+static int bmp_draw_number(BmpCanvas* cv, int number, int x0, int y0, int scale, BmpColor col) {
     char buf[16];
     snprintf(buf, sizeof(buf), "%d", number);
 
@@ -276,7 +363,7 @@ static int bmp_draw_number(uint8_t *image, int row_size, int width, int height,
 
     for (int i = 0; buf[i] != '\0'; i++) {
         if (buf[i] >= '0' && buf[i] <= '9') {
-            bmp_draw_digit(image, row_size, width, height, buf[i] - '0', x, y0, scale, col);
+            bmp_draw_digit(cv, buf[i] - '0', x, y0, scale, col);
         }
         x += char_w + gap;
     }
@@ -287,189 +374,1148 @@ static int bmp_draw_number(uint8_t *image, int row_size, int width, int height,
 /**
  * Desenha o rótulo de uma tarefa (ex: "T0", "T1", ...)
  */
-static void bmp_draw_task_label(uint8_t *image, int row_size, int width, int height,
-                                int task_id, int x0, int y0, int scale, BmpColor col) {
+static void bmp_draw_task_label(BmpCanvas* cv, int task_id, int x0, int y0, int scale,
+                                BmpColor col) {
     int char_w = 3 * scale;
     int gap = scale;
 
-    bmp_draw_letter_T(image, row_size, width, height, x0, y0, scale, col);
-    bmp_draw_number(image, row_size, width, height, task_id,
-                    x0 + char_w + gap, y0, scale, col);
+    bmp_draw_letter(cv, letter_T, x0, y0, scale, col);
+    bmp_draw_number(cv, task_id, x0 + char_w + gap, y0, scale, col);
+}
+
+/**
+ * Desenha o rótulo "MISS" da faixa de perdas de prazo
+ */
+static void bmp_draw_miss_label(BmpCanvas* cv, int x0, int y0, int scale, BmpColor col) {
+    const uint8_t* glyphs[4] = {letter_M, letter_I, letter_S, letter_S};
+    int advance = 4 * scale;
+
+    for (int i = 0; i < 4; i++) {
+        bmp_draw_letter(cv, glyphs[i], x0 + i * advance, y0, scale, col);
+    }
+}
+
+/**
+ * Desenha o rótulo "CS" da linha de overhead de troca de contexto
+ */
+static void bmp_draw_cs_label(BmpCanvas* cv, int x0, int y0, int scale, BmpColor col) {
+    bmp_draw_letter(cv, letter_C, x0, y0, scale, col);
+    bmp_draw_letter(cv, letter_S, x0 + 4 * scale, y0, scale, col);
 }
 
 /* ============================================================================
- * FUNÇÃO PÚBLICA DE GERAÇÃO DO GRÁFICO DE GANTT
+ * LAYOUT DO GRÁFICO
  * ============================================================================ */
 
-void create_gantt_bmp(const char* filename, GanttEntry* entries, int entry_count,
-                      int total_time, int task_count) {
+/* Tudo o que é calculado uma vez por imagem e usado por todas as faixas */
+typedef struct {
+    const GanttEntry* entries;  /* Entradas do Gantt */
+    int entry_count;
+    const GanttPalette* palette;
+    const GanttBmpOptions* options;
+    int total_time;
+    int task_count;             /* Linhas de tarefas */
+    int row_count;              /* task_count + linha "CS" (se houver) */
+    int has_overhead;
+    int has_misses;
+    int width, height;
+    int chart_height;
+    int strip_y;                /* Topo da faixa MISS (-1 = sem faixa) */
+    TimeAxis axis;
+
+    GanttIndex index;           /* Entradas de cada linha (a "CS" é task_count) */
+
+    BmpColor* row_colors;       /* Cor de cada linha, tirada da paleta */
+    float* lod_busy;            /* Ocupação por linha e coluna (modo LOD) */
+} GanttLayout;
 
-    /* Calcular dimensões */
-    int time_scale = MIN_TICK_WIDTH;
-    int chart_width = total_time * time_scale;
+/**
+ * Linha do gráfico onde a entrada é desenhada
+ */
+static int entry_row(const GanttLayout* L, const GanttEntry* entry) {
+    return (entry->task_id == GANTT_OVERHEAD_ID) ? L->task_count : entry->task_id;
+}
 
-    int width = MARGIN_LEFT + chart_width + MARGIN_RIGHT;
-    if (width < 400) width = 400;
+/**
+ * Agrupa as entradas por linha (gantt_index). Entradas de tarefa inválida
+ * ficam fora do índice e não são desenhadas.
+ */
+static int layout_index_rows(GanttLayout* L) {
+    return gantt_index_build(&L->index, L->entries, L->entry_count, L->task_count);
+}
 
-    int chart_height = task_count * (ROW_HEIGHT + ROW_SPACING);
-    int height = MARGIN_TOP + chart_height + MARGIN_BOTTOM;
-    if (height < 200) height = 200;
+/**
+ * Converte a cor de cada linha da paleta uma vez por imagem
+ */
+static int layout_row_colors(GanttLayout* L) {
+    L->row_colors = malloc(L->row_count * sizeof(BmpColor));
+    if (!L->row_colors) return 0;
+
+    for (int row = 0; row < L->row_count; row++) {
+        int task_id = (row < L->task_count) ? row : GANTT_OVERHEAD_ID;
+        const GanttColor* color = gantt_palette_color(L->palette, task_id);
+        L->row_colors[row].r = color->r;
+        L->row_colors[row].g = color->g;
+        L->row_colors[row].b = color->b;
+    }
+    return 1;
+}
 
-    time_scale = (width - MARGIN_LEFT - MARGIN_RIGHT) / (total_time > 0 ? total_time : 1);
-    if (time_scale < MIN_TICK_WIDTH) time_scale = MIN_TICK_WIDTH;
+/**
+ * Modo LOD: uma passada pelas entradas acumula a fração de cada coluna de
+ * pixels ocupada por cada linha. O custo depende do número de entradas e
+ * de pixels, não de ticks.
+ */
+static int layout_lod_coverage(GanttLayout* L) {
+    int columns = L->axis.chart_width;
+    L->lod_busy = calloc((size_t)L->row_count * columns, sizeof(float));
+    if (!L->lod_busy) return 0;
+
+    double cols_per_tick = (double)columns / L->axis.total_time;
+    for (int i = 0; i < L->entry_count; i++) {
+        const GanttEntry* entry = &L->entries[i];
+        int row = entry_row(L, entry);
+        if (row < 0 || row >= L->row_count) continue;
+
+        double s = entry->start_time * cols_per_tick;
+        double e = entry->end_time * cols_per_tick;
+        for (int c = (int)s; c < columns && c < e; c++) {
+            double lo = (s > c) ? s : c;
+            double hi = (e < c + 1) ? e : c + 1;
+            L->lod_busy[(size_t)row * columns + c] += (float)(hi - lo);
+        }
+    }
+    return 1;
+}
 
-    /* Alocar buffer */
-    int padding = (4 - (width * 3) % 4) % 4;
-    int row_size = width * 3 + padding;
+static void layout_free(GanttLayout* L) {
+    gantt_index_free(&L->index);
+    free(L->row_colors);
+    free(L->lod_busy);
+}
 
-    uint8_t* image = calloc(row_size * height, 1);
-    if (!image) {
-        printf("Erro: Não foi possível alocar memória para a imagem.\n");
-        return;
+/* ============================================================================
+ * RASTERIZAÇÃO DE UMA FAIXA
+ * ============================================================================ */
+
+/**
+ * Primeira e última linha de tarefa que podem tocar a faixa
+ */
+static void band_rows(const GanttLayout* L, const BmpCanvas* cv, int* first, int* last) {
+    int stride = ROW_HEIGHT + ROW_SPACING;
+    *first = (cv->y0 - MARGIN_TOP - stride) / stride;
+    *last = (cv->y1 - MARGIN_TOP) / stride + 1;
+    if (*first < 0) *first = 0;
+    if (*last > L->row_count - 1) *last = L->row_count - 1;
+}
+
+/**
+ * Desenha uma barra de execução (modo normal)
+ */
+static void band_draw_entry(BmpCanvas* cv, const GanttLayout* L, const GanttEntry* entry) {
+    int row = entry_row(L, entry);
+    BmpColor task_color = L->row_colors[row];
+    BmpColor border_color = bmp_darken_color(task_color, 0.6f);
+
+    int y_start = MARGIN_TOP + row * (ROW_HEIGHT + ROW_SPACING);
+    int y_bar_start = y_start + (ROW_HEIGHT - BAR_HEIGHT) / 2;
+    int y_bar_end = y_bar_start + BAR_HEIGHT;
+
+    int x_start = MARGIN_LEFT + entry->start_time * L->axis.time_scale;
+    int x_end = MARGIN_LEFT + entry->end_time * L->axis.time_scale - 1;
+
+    if (x_end <= x_start) x_end = x_start + 1;
+
+    bmp_draw_rect_bordered(cv, x_start, y_bar_start, x_end, y_bar_end,
+                           task_color, border_color, 2);
+}
+
+/**
+ * Desenha as colunas de uma linha no modo LOD: cor da tarefa, mais clara
+ * quanto menor a ocupação da coluna
+ */
+static void band_draw_lod_row(BmpCanvas* cv, const GanttLayout* L, int row) {
+    BmpColor bg = {COLOR_BACKGROUND_R, COLOR_BACKGROUND_G, COLOR_BACKGROUND_B};
+    BmpColor alt_row = {COLOR_ALT_ROW_R, COLOR_ALT_ROW_G, COLOR_ALT_ROW_B};
+    int columns = L->axis.chart_width;
+
+    int y_start = MARGIN_TOP + row * (ROW_HEIGHT + ROW_SPACING);
+    int y_bar_start = y_start + (ROW_HEIGHT - BAR_HEIGHT) / 2;
+    int y_bar_end = y_bar_start + BAR_HEIGHT;
+    BmpColor row_bg = (row % 2 == 1) ? alt_row : bg;
+
+    for (int c = 0; c < columns; c++) {
+        float used = L->lod_busy[(size_t)row * columns + c];
+        if (used <= 0.0f) continue;
+        if (used > 1.0f) used = 1.0f;
+
+        /* Colunas pouco ocupadas continuam visíveis (mínimo de 25%) */
+        BmpColor fill = bmp_blend_color(row_bg, L->row_colors[row], 0.25f + 0.75f * used);
+        BmpColor border = bmp_darken_color(fill, 0.6f);
+        int x = MARGIN_LEFT + c;
+
+        bmp_draw_vline(cv, x, y_bar_start, y_bar_end, fill);
+        bmp_draw_vline(cv, x, y_bar_start, y_bar_start + 1, border);
+        bmp_draw_vline(cv, x, y_bar_end - 1, y_bar_end, border);
+    }
+}
+
+/**
+ * Desenha os marcadores de prazo sobre as linhas das tarefas e, para as
+ * perdas, os traços na faixa de perdas (se strip_y >= 0)
+ */
+static void band_draw_markers(BmpCanvas* cv, const GanttLayout* L) {
+    BmpColor deadline_color = {COLOR_DEADLINE_R, COLOR_DEADLINE_G, COLOR_DEADLINE_B};
+    BmpColor miss_color = {COLOR_MISS_R, COLOR_MISS_G, COLOR_MISS_B};
+    const GanttMarker* markers = L->options->markers;
+    int strip_y = L->strip_y;
+
+    for (int i = 0; i < L->options->marker_count; i++) {
+        const GanttMarker* m = &markers[i];
+        int x = axis_x(&L->axis, m->time);
+
+        if (m->task_id >= 0 && m->task_id < L->task_count) {
+            int y_start = MARGIN_TOP + m->task_id * (ROW_HEIGHT + ROW_SPACING);
+            BmpColor col = (m->kind == GANTT_MARK_MISS) ? miss_color : deadline_color;
+
+            if (y_start <= cv->y1 && y_start + ROW_HEIGHT >= cv->y0) {
+                /* Linha vertical do prazo na linha da tarefa */
+                bmp_draw_filled_rect(cv, x - 1, y_start, x, y_start + ROW_HEIGHT, col);
+
+                /* Perda: bandeira no topo da linha */
+                if (m->kind == GANTT_MARK_MISS) {
+                    bmp_draw_filled_rect(cv, x + 1, y_start, x + 6, y_start + 4, col);
+                }
+            }
+        }
+
+        /* Linha do tempo das perdas */
+        if (m->kind == GANTT_MARK_MISS && strip_y >= 0) {
+            bmp_draw_filled_rect(cv, x - 1, strip_y + 2, x + 1, strip_y + MISS_STRIP_HEIGHT - 8,
+                                 miss_color);
+        }
     }
+}
+
+/**
+ * Rasteriza as linhas [cv->y0, cv->y1) da imagem. A ordem de desenho é a
+ * mesma para todas as faixas (fundo, grade, rótulos, barras, marcadores,
+ * legenda), então juntar as faixas dá a imagem completa.
+ */
+static void render_band(BmpCanvas* cv, const GanttLayout* L) {
+    int width = L->width;
+    int height = L->height;
+    int chart_height = L->chart_height;
+    int total_time = L->total_time;
+    int first_row, last_row;
+    band_rows(L, cv, &first_row, &last_row);
 
     /* Desenhar fundo branco */
     BmpColor bg = {COLOR_BACKGROUND_R, COLOR_BACKGROUND_G, COLOR_BACKGROUND_B};
-    bmp_draw_filled_rect(image, row_size, width, height, 0, 0, width - 1, height - 1, bg);
+    bmp_draw_filled_rect(cv, 0, cv->y0, width - 1, cv->y1 - 1, bg);
 
     /* Fundo alternado (zebra) */
     BmpColor alt_row = {COLOR_ALT_ROW_R, COLOR_ALT_ROW_G, COLOR_ALT_ROW_B};
-    for (int i = 0; i < task_count; i++) {
+    for (int i = first_row; i <= last_row; i++) {
         if (i % 2 == 1) {
             int y_start = MARGIN_TOP + i * (ROW_HEIGHT + ROW_SPACING);
             int y_end = y_start + ROW_HEIGHT;
-            bmp_draw_filled_rect(image, row_size, width, height,
-                                MARGIN_LEFT, y_start,
-                                width - MARGIN_RIGHT, y_end, alt_row);
+            bmp_draw_filled_rect(cv, MARGIN_LEFT, y_start, width - MARGIN_RIGHT, y_end, alt_row);
         }
     }
 
-    /* Grade vertical (linhas de tempo) */
+    /* Grade vertical (linhas de tempo) e rótulos de tempo */
     BmpColor grid = {COLOR_GRID_R, COLOR_GRID_G, COLOR_GRID_B};
     BmpColor grid_major = {COLOR_GRID_MAJOR_R, COLOR_GRID_MAJOR_G, COLOR_GRID_MAJOR_B};
     BmpColor text_color = {0, 0, 0};
 
-    for (int t = 0; t <= total_time; t++) {
-        int x = MARGIN_LEFT + t * time_scale;
+    int grid_in_band = (MARGIN_TOP < cv->y1 && MARGIN_TOP + chart_height >= cv->y0);
+    int labels_in_band = (MARGIN_TOP - 20 < cv->y1 && MARGIN_TOP - 10 >= cv->y0);
 
-        BmpColor line_color = (t % 5 == 0) ? grid_major : grid;
-        bmp_draw_vline(image, row_size, width, height,
-                      x, MARGIN_TOP, MARGIN_TOP + chart_height, line_color);
+    if (L->axis.lod && (grid_in_band || labels_in_band)) {
+        /* Rótulos a cada intervalo redondo; grade menor só se couber */
+        int label_interval = bmp_label_interval(&L->axis, 60);
+        int minor = (label_interval % 5 == 0) ? label_interval / 5
+                  : (label_interval % 2 == 0) ? label_interval / 2 : 0;
+        if (minor > 0 && (long long)minor * L->axis.chart_width < 4LL * L->axis.total_time) {
+            minor = 0;
+        }
 
-        /* Rótulos de tempo */
-        int label_interval = 1;
-        if (total_time > 50) label_interval = 10;
-        else if (total_time > 20) label_interval = 5;
-        else if (total_time > 10) label_interval = 2;
+        int step = (minor > 0) ? minor : label_interval;
+        for (long long t = 0; t <= total_time; t += step) {
+            int x = axis_x(&L->axis, t);
+            int major = (t % label_interval == 0);
+
+            bmp_draw_vline(cv, x, MARGIN_TOP, MARGIN_TOP + chart_height, major ? grid_major : grid);
+            if (major) {
+                char buf[24];
+                snprintf(buf, sizeof(buf), "%lld", t);
+                int text_width = strlen(buf) * 4 * 2;
+                bmp_draw_number(cv, (int)t, x - text_width / 4, MARGIN_TOP - 20, 2, text_color);
+            }
+        }
+    }
 
-        if (t % label_interval == 0) {
+    /* Rótulos de tempo */
+    int label_interval = 1;
+    if (total_time > 50) label_interval = 10;
+    else if (total_time > 20) label_interval = 5;
+    else if (total_time > 10) label_interval = 2;
+
+    for (int t = 0; !L->axis.lod && (grid_in_band || labels_in_band) && t <= total_time; t++) {
+        int x = MARGIN_LEFT + t * L->axis.time_scale;
+
+        BmpColor line_color = (t % 5 == 0) ? grid_major : grid;
+        bmp_draw_vline(cv, x, MARGIN_TOP, MARGIN_TOP + chart_height, line_color);
+
+        if (t % label_interval == 0 && labels_in_band) {
             char buf[16];
             snprintf(buf, sizeof(buf), "%d", t);
             int text_width = strlen(buf) * 4 * 2;
-            bmp_draw_number(image, row_size, width, height, t,
-                           x - text_width / 4, MARGIN_TOP - 20, 2, text_color);
+            bmp_draw_number(cv, t, x - text_width / 4, MARGIN_TOP - 20, 2, text_color);
         }
     }
 
     /* Linhas horizontais (separadores de tarefas) */
-    bmp_draw_hline(image, row_size, width, height,
-                  MARGIN_LEFT, width - MARGIN_RIGHT, MARGIN_TOP, grid_major);
+    bmp_draw_hline(cv, MARGIN_LEFT, width - MARGIN_RIGHT, MARGIN_TOP, grid_major);
 
-    for (int i = 0; i <= task_count; i++) {
+    for (int i = first_row; i <= last_row + 1; i++) {
         int y = MARGIN_TOP + i * (ROW_HEIGHT + ROW_SPACING);
-        bmp_draw_hline(image, row_size, width, height,
-                      MARGIN_LEFT, width - MARGIN_RIGHT, y, grid_major);
+        bmp_draw_hline(cv, MARGIN_LEFT, width - MARGIN_RIGHT, y, grid_major);
     }
 
     /* Rótulos das tarefas (T0, T1, ...) */
-    for (int i = 0; i < task_count; i++) {
+    for (int i = first_row; i <= last_row && i < L->task_count; i++) {
         int y_center = MARGIN_TOP + i * (ROW_HEIGHT + ROW_SPACING) + ROW_HEIGHT / 2;
-        bmp_draw_task_label(image, row_size, width, height, i,
-                           15, y_center - 5, 2, text_color);
+        bmp_draw_task_label(cv, gantt_palette_label(L->palette, i), 15, y_center - 5, 2, text_color);
+    }
+    if (L->has_overhead) {
+        int y_center = MARGIN_TOP + L->task_count * (ROW_HEIGHT + ROW_SPACING) + ROW_HEIGHT / 2;
+        bmp_draw_cs_label(cv, 15, y_center - 5, 2, text_color);
     }
 
-    /* Barras de execução das tarefas */
-    for (int i = 0; i < entry_count; i++) {
-        GanttEntry* entry = &entries[i];
-        BmpColor task_color = bmp_hex_to_rgb(entry->color);
-        BmpColor border_color = bmp_darken_color(task_color, 0.6f);
-
-        int y_start = MARGIN_TOP + entry->task_id * (ROW_HEIGHT + ROW_SPACING);
-        int y_bar_start = y_start + (ROW_HEIGHT - BAR_HEIGHT) / 2;
-        int y_bar_end = y_bar_start + BAR_HEIGHT;
-
-        int x_start = MARGIN_LEFT + entry->start_time * time_scale;
-        int x_end = MARGIN_LEFT + entry->end_time * time_scale - 1;
-
-        if (x_end <= x_start) x_end = x_start + 1;
+    /* Barras de execução das tarefas (só as linhas que tocam a faixa) */
+    for (int r = first_row; r <= last_row; r++) {
+        if (L->axis.lod) {
+            band_draw_lod_row(cv, L, r);
+            continue;
+        }
+        const GanttIndexRow* list = &L->index.rows[r];
+        for (int k = 0; k < list->count; k++) {
+            band_draw_entry(cv, L, &L->entries[list->items[k]]);
+        }
+    }
 
-        bmp_draw_rect_bordered(image, row_size, width, height,
-                              x_start, y_bar_start, x_end, y_bar_end,
-                              task_color, border_color, 2);
+    /* Prazos e linha do tempo de perdas */
+    if (L->has_misses) {
+        bmp_draw_hline(cv, MARGIN_LEFT, width - MARGIN_RIGHT,
+                       L->strip_y + MISS_STRIP_HEIGHT - 6, grid_major);
+        bmp_draw_miss_label(cv, 15, L->strip_y + 4, 2, text_color);
+    }
+    if (L->options->marker_count > 0) {
+        band_draw_markers(cv, L);
     }
 
     /* Legenda */
     int legend_y = height - MARGIN_BOTTOM + 15;
     int legend_x = MARGIN_LEFT;
 
-    for (int i = 0; i < task_count && i < 8; i++) {
-        BmpColor task_color = {128, 128, 128};
-        for (int j = 0; j < entry_count; j++) {
-            if (entries[j].task_id == i) {
-                task_color = bmp_hex_to_rgb(entries[j].color);
-                break;
-            }
-        }
-
+    for (int i = 0; i < L->task_count && i < 8; i++) {
         int sq_size = 12;
+        BmpColor task_color = L->row_colors[i];
         BmpColor border = bmp_darken_color(task_color, 0.6f);
-        bmp_draw_rect_bordered(image, row_size, width, height,
-                              legend_x, legend_y,
-                              legend_x + sq_size, legend_y + sq_size,
-                              task_color, border, 1);
+        bmp_draw_rect_bordered(cv, legend_x, legend_y, legend_x + sq_size, legend_y + sq_size,
+                               task_color, border, 1);
 
-        bmp_draw_task_label(image, row_size, width, height, i,
-                           legend_x + sq_size + 5, legend_y + 2, 1, text_color);
+        bmp_draw_task_label(cv, gantt_palette_label(L->palette, i), legend_x + sq_size + 5,
+                            legend_y + 2, 1, text_color);
 
         legend_x += 50;
     }
+}
+
+/* ============================================================================
+ * GRAVAÇÃO DA IMAGEM (BMP 24/8 BITS, RLE8, PNG)
+ * ============================================================================ */
+
+#define PALETTE_SIZE    256
+
+/* Gravador de um arquivo de imagem que recebe as faixas já rasterizadas */
+typedef struct {
+    FILE* f;
+    GanttImageFormat format;
+    int width, height;
+    int row_size;               /* Bytes por linha nas faixas (BGR) */
+    int failed;                 /* Faltou memória durante a gravação */
+
+    /* Formatos com paleta (BMP de 8 bits e RLE8): uma primeira passada
+     * conta as cores da imagem e a paleta é montada antes da gravação */
+    int counting;               /* 1ª passada: só contar as cores */
+    BmpColor palette[PALETTE_SIZE];
+    int palette_count;
+    int palette_reduced;        /* Mais de 256 cores: paleta por corte mediano */
+    uint32_t* color_keys;       /* Hash de cores (0 = vazio, senão cor | 1 << 24) */
+    uint32_t* color_counts;     /* Pixels de cada cor */
+    uint8_t* color_index;       /* Índice de cada cor na paleta */
+    size_t color_capacity;      /* Posições do hash (potência de 2) */
+    size_t color_count;         /* Cores distintas */
+    size_t pixel_bytes;         /* Bytes de pixels gravados */
+
+    uint8_t* line;              /* Linha convertida (índices ou RGB filtrado) */
+    uint8_t* encoded;           /* RLE8: linha comprimida; PNG: linha anterior */
+
+    Deflate z;                  /* PNG: fluxo zlib dos dados */
+} ImageWriter;
+
+/* Cor com a sua contagem, para o corte mediano */
+typedef struct {
+    uint32_t rgb;
+    uint32_t count;
+    uint8_t key;                /* Canal usado na ordenação atual */
+} ColorCount;
+
+/* RLE8 só existe de baixo para cima: as faixas são geradas na ordem inversa */
+static int writer_bottom_up(const ImageWriter* w) {
+    return w->format == GANTT_IMAGE_RLE8;
+}
+
+static int writer_indexed(const ImageWriter* w) {
+    return w->format == GANTT_IMAGE_BMP8 || w->format == GANTT_IMAGE_RLE8;
+}
+
+/**
+ * Grava um inteiro de 32 bits em big-endian (PNG)
+ */
+static void put_be32(uint8_t* p, uint32_t v) {
+    p[0] = (v >> 24) & 0xFF;
+    p[1] = (v >> 16) & 0xFF;
+    p[2] = (v >> 8) & 0xFF;
+    p[3] = v & 0xFF;
+}
+
+/**
+ * CRC-32 dos blocos PNG (tabela montada no primeiro uso)
+ */
+static uint32_t png_crc(uint32_t crc, const uint8_t* data, size_t size) {
+    static uint32_t table[256];
+    static int table_ready = 0;
+
+    if (!table_ready) {
+        for (uint32_t n = 0; n < 256; n++) {
+            uint32_t c = n;
+            for (int k = 0; k < 8; k++) {
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            }
+            table[n] = c;
+        }
+        table_ready = 1;
+    }
+
+    crc = ~crc;
+    for (size_t i = 0; i < size; i++) {
+        crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+/**
+ * Grava um bloco PNG (tamanho, tipo, dados, CRC)
+ */
+static void png_write_chunk(FILE* f, const char* type, const uint8_t* data, size_t size) {
+    uint8_t word[4];
+
+    put_be32(word, (uint32_t)size);
+    fwrite(word, 1, 4, f);
+    fwrite(type, 1, 4, f);
+    if (size > 0) fwrite(data, 1, size, f);
+
+    uint32_t crc = png_crc(0, (const uint8_t*)type, 4);
+    crc = png_crc(crc, data, size);
+    put_be32(word, crc);
+    fwrite(word, 1, 4, f);
+}
+
+/* Saída do deflate: cada pedaço vira um bloco IDAT */
+static void png_write_idat(void* ctx, const uint8_t* data, size_t size) {
+    png_write_chunk((FILE*)ctx, "IDAT", data, size);
+}
+
+/**
+ * Posição da cor no hash (a sua, ou a vazia onde ela entraria)
+ */
+static size_t color_slot(const uint32_t* keys, size_t capacity, uint32_t rgb) {
+    uint32_t key = rgb | (1u << 24);
+    uint32_t h = rgb ^ (rgb >> 13);
+    h *= 0x5BD1E995u;
+    h ^= h >> 15;
+
+    size_t i = h & (capacity - 1);
+    while (keys[i] != 0 && keys[i] != key) {
+        i = (i + 1) & (capacity - 1);
+    }
+    return i;
+}
+
+/**
+ * Dobra o hash de cores
+ */
+static int color_table_grow(ImageWriter* w) {
+    size_t capacity = w->color_capacity * 2;
+    uint32_t* keys = calloc(capacity, sizeof(uint32_t));
+    uint32_t* counts = calloc(capacity, sizeof(uint32_t));
+    uint8_t* index = calloc(capacity, 1);
+    if (!keys || !counts || !index) {
+        free(keys);
+        free(counts);
+        free(index);
+        return 0;
+    }
+
+    for (size_t i = 0; i < w->color_capacity; i++) {
+        if (w->color_keys[i] == 0) continue;
+        size_t s = color_slot(keys, capacity, w->color_keys[i] & 0xFFFFFF);
+        keys[s] = w->color_keys[i];
+        counts[s] = w->color_counts[i];
+    }
+
+    free(w->color_keys);
+    free(w->color_counts);
+    free(w->color_index);
+    w->color_keys = keys;
+    w->color_counts = counts;
+    w->color_index = index;
+    w->color_capacity = capacity;
+    return 1;
+}
+
+/**
+ * Soma n pixels da cor rgb (1ª passada)
+ */
+static void count_color(ImageWriter* w, uint32_t rgb, uint32_t n) {
+    size_t s = color_slot(w->color_keys, w->color_capacity, rgb);
+
+    if (w->color_keys[s] == 0) {
+        /* Carga máxima de 1/2 */
+        if ((w->color_count + 1) * 2 > w->color_capacity) {
+            if (!color_table_grow(w)) {
+                w->failed = 1;
+                return;
+            }
+            s = color_slot(w->color_keys, w->color_capacity, rgb);
+        }
+        w->color_keys[s] = rgb | (1u << 24);
+        w->color_count++;
+    }
+    w->color_counts[s] += n;
+}
+
+/**
+ * Conta as cores de uma linha BGR (trechos de mesma cor de uma vez)
+ */
+static void count_row(ImageWriter* w, const uint8_t* bgr) {
+    uint32_t run_rgb = 0;
+    uint32_t run = 0;
+
+    for (int x = 0; x < w->width; x++) {
+        const uint8_t* p = bgr + x * 3;
+        uint32_t rgb = ((uint32_t)p[2] << 16) | ((uint32_t)p[1] << 8) | p[0];
+        if (run > 0 && rgb != run_rgb) {
+            count_color(w, run_rgb, run);
+            run = 0;
+        }
+        run_rgb = rgb;
+        run++;
+    }
+    if (run > 0) count_color(w, run_rgb, run);
+}
+
+static int compare_color_key(const void* a, const void* b) {
+    const ColorCount* x = (const ColorCount*)a;
+    const ColorCount* y = (const ColorCount*)b;
+    if (x->key != y->key) return (x->key < y->key) ? -1 : 1;
+    return (x->rgb < y->rgb) ? -1 : (x->rgb > y->rgb);
+}
+
+/**
+ * Canal de maior amplitude de um grupo de cores (0 = R, 1 = G, 2 = B)
+ */
+static int box_widest_channel(const ColorCount* colors, int start, int end, int* range) {
+    int lo[3] = {255, 255, 255};
+    int hi[3] = {0, 0, 0};
+
+    for (int i = start; i < end; i++) {
+        for (int c = 0; c < 3; c++) {
+            int v = (colors[i].rgb >> (16 - 8 * c)) & 0xFF;
+            if (v < lo[c]) lo[c] = v;
+            if (v > hi[c]) hi[c] = v;
+        }
+    }
+
+    int widest = 0;
+    for (int c = 1; c < 3; c++) {
+        if (hi[c] - lo[c] > hi[widest] - lo[widest]) widest = c;
+    }
+    *range = hi[widest] - lo[widest];
+    return widest;
+}
+
+/**
+ * Monta a paleta a partir das cores contadas. Com até 256 cores, cada uma
+ * tem o seu índice; acima disso, corte mediano: o grupo de maior amplitude
+ * é dividido no canal mais largo, na mediana ponderada pelos pixels, até
+ * haver 256 grupos, e cada grupo vira a média das suas cores.
+ */
+static int writer_build_palette(ImageWriter* w) {
+    int n = (int)w->color_count;
+    ColorCount* colors = malloc((n > 0 ? n : 1) * sizeof(ColorCount));
+    int* box_start = malloc((PALETTE_SIZE + 1) * sizeof(int));
+    if (!colors || !box_start) {
+        free(colors);
+        free(box_start);
+        return 0;
+    }
+
+    int k = 0;
+    for (size_t i = 0; i < w->color_capacity; i++) {
+        if (w->color_keys[i] == 0) continue;
+        colors[k].rgb = w->color_keys[i] & 0xFFFFFF;
+        colors[k].count = w->color_counts[i];
+        colors[k].key = 0;
+        k++;
+    }
+
+    /* Grupos [box_start[b], box_start[b + 1]) */
+    int boxes = 1;
+    box_start[0] = 0;
+    box_start[1] = n;
+
+    while (n > PALETTE_SIZE && boxes < PALETTE_SIZE) {
+        int best = -1, best_range = 0, best_channel = 0;
+        for (int b = 0; b < boxes; b++) {
+            if (box_start[b + 1] - box_start[b] < 2) continue;
+            int range;
+            int channel = box_widest_channel(colors, box_start[b], box_start[b + 1], &range);
+            if (best < 0 || range > best_range) {
+                best = b;
+                best_range = range;
+                best_channel = channel;
+            }
+        }
+        if (best < 0) break;
+
+        int start = box_start[best];
+        int end = box_start[best + 1];
+        unsigned long long total = 0;
+        for (int i = start; i < end; i++) {
+            colors[i].key = (colors[i].rgb >> (16 - 8 * best_channel)) & 0xFF;
+            total += colors[i].count;
+        }
+        qsort(colors + start, end - start, sizeof(ColorCount), compare_color_key);
+
+        int split = start + 1;
+        unsigned long long acc = 0;
+        for (int i = start; i < end - 1; i++) {
+            acc += colors[i].count;
+            split = i + 1;
+            if (acc * 2 >= total) break;
+        }
+
+        memmove(box_start + best + 2, box_start + best + 1, (boxes - best) * sizeof(int));
+        box_start[best + 1] = split;
+        boxes++;
+    }
+
+    /* Cor de cada grupo (média ponderada) e índice de cada cor */
+    w->palette_count = (n <= PALETTE_SIZE) ? n : boxes;
+    w->palette_reduced = (n > PALETTE_SIZE);
+    for (int b = 0; b < w->palette_count; b++) {
+        int start = (n <= PALETTE_SIZE) ? b : box_start[b];
+        int end = (n <= PALETTE_SIZE) ? b + 1 : box_start[b + 1];
+        unsigned long long sum[3] = {0, 0, 0}, total = 0;
+
+        for (int i = start; i < end; i++) {
+            for (int c = 0; c < 3; c++) {
+                sum[c] += (unsigned long long)((colors[i].rgb >> (16 - 8 * c)) & 0xFF) * colors[i].count;
+            }
+            total += colors[i].count;
+
+            size_t s = color_slot(w->color_keys, w->color_capacity, colors[i].rgb);
+            w->color_index[s] = (uint8_t)b;
+        }
+        if (total == 0) total = 1;
+        w->palette[b].r = (uint8_t)((sum[0] + total / 2) / total);
+        w->palette[b].g = (uint8_t)((sum[1] + total / 2) / total);
+        w->palette[b].b = (uint8_t)((sum[2] + total / 2) / total);
+    }
+
+    free(colors);
+    free(box_start);
+    return 1;
+}
+
+/**
+ * Converte uma linha BGR em índices da paleta
+ */
+static void writer_index_row(ImageWriter* w, const uint8_t* bgr) {
+    uint32_t last_rgb = 0;
+    uint8_t last_index = 0;
+
+    for (int x = 0; x < w->width; x++) {
+        const uint8_t* p = bgr + x * 3;
+        uint32_t rgb = ((uint32_t)p[2] << 16) | ((uint32_t)p[1] << 8) | p[0];
+        if (x == 0 || rgb != last_rgb) {
+            last_rgb = rgb;
+            last_index = w->color_index[color_slot(w->color_keys, w->color_capacity, rgb)];
+        }
+        w->line[x] = last_index;
+    }
+}
+
+/**
+ * Comprime uma linha de índices em BI_RLE8; retorna o tamanho gerado
+ */
+static size_t rle8_encode_row(const uint8_t* idx, int width, uint8_t* out) {
+    size_t n = 0;
+    int x = 0;
+
+    while (x < width) {
+        /* Repetição: (contagem, índice) */
+        int run = 1;
+        while (x + run < width && run < 255 && idx[x + run] == idx[x]) run++;
+        if (run >= 2) {
+            out[n++] = (uint8_t)run;
+            out[n++] = idx[x];
+            x += run;
+            continue;
+        }
+
+        /* Trecho sem repetição: até onde começa a próxima */
+        int lit = 1;
+        while (x + lit < width && lit < 255 &&
+               !(x + lit + 1 < width && idx[x + lit] == idx[x + lit + 1])) {
+            lit++;
+        }
+
+        if (lit < 3) {
+            /* Modo absoluto exige pelo menos 3 pixels */
+            for (int i = 0; i < lit; i++) {
+                out[n++] = 1;
+                out[n++] = idx[x + i];
+            }
+        } else {
+            out[n++] = 0;
+            out[n++] = (uint8_t)lit;
+            memcpy(out + n, idx + x, lit);
+            n += lit;
+            if (lit & 1) out[n++] = 0;  /* Alinhamento em 16 bits */
+        }
+        x += lit;
+    }
+
+    /* Fim de linha */
+    out[n++] = 0;
+    out[n++] = 0;
+    return n;
+}
+
+/**
+ * Cabeçalhos BMP para o formato do gravador (size = bytes de pixels)
+ */
+static void bmp_write_headers(ImageWriter* w, size_t pixel_bytes) {
+    int indexed = (w->format != GANTT_IMAGE_BMP24);
+    uint32_t offset = 54 + (indexed ? PALETTE_SIZE * 4 : 0);
 
-    /* Escrever arquivo BMP */
     BMPFileHeader file_header = {
         .type = 0x4D42,
-        .size = 54 + row_size * height,
+        .size = offset + (uint32_t)pixel_bytes,
         .reserved1 = 0,
         .reserved2 = 0,
-        .offset = 54
+        .offset = offset
     };
 
     BMPInfoHeader info_header = {
         .header_size = 40,
-        .width = width,
-        .height = -height,
+        .width = w->width,
+        .height = writer_bottom_up(w) ? w->height : -w->height,
         .planes = 1,
-        .bits_per_pixel = 24,
-        .compression = 0,
-        .image_size = row_size * height,
+        .bits_per_pixel = indexed ? 8 : 24,
+        .compression = (w->format == GANTT_IMAGE_RLE8) ? 1 : 0,
+        .image_size = (uint32_t)pixel_bytes,
         .x_pixels_per_meter = 2835,
         .y_pixels_per_meter = 2835,
-        .colors_used = 0,
+        .colors_used = indexed ? PALETTE_SIZE : 0,
         .important_colors = 0
     };
 
-    FILE* f = fopen(filename, "wb");
-    if (!f) {
-        printf("Erro: Não foi possível criar o arquivo %s\n", filename);
-        free(image);
+    fwrite(&file_header, sizeof(BMPFileHeader), 1, w->f);
+    fwrite(&info_header, sizeof(BMPInfoHeader), 1, w->f);
+
+    if (indexed) {
+        uint8_t table[PALETTE_SIZE * 4];
+        memset(table, 0, sizeof(table));
+        for (int i = 0; i < w->palette_count; i++) {
+            table[i * 4] = w->palette[i].b;
+            table[i * 4 + 1] = w->palette[i].g;
+            table[i * 4 + 2] = w->palette[i].r;
+        }
+        fwrite(table, 1, sizeof(table), w->f);
+    }
+}
+
+static void writer_free(ImageWriter* w) {
+    if (w->format == GANTT_IMAGE_PNG) deflate_free(&w->z);
+    free(w->color_keys);
+    free(w->color_counts);
+    free(w->color_index);
+    free(w->line);
+    free(w->encoded);
+}
+
+/**
+ * Abre o arquivo e grava os cabeçalhos. Nos formatos com paleta os
+ * cabeçalhos são provisórios (o tamanho do RLE8 só é conhecido no fim) e o
+ * gravador começa contando as cores.
+ */
+static int writer_open(ImageWriter* w, const char* filename, GanttImageFormat format,
+                       int width, int height, int row_size) {
+    memset(w, 0, sizeof(ImageWriter));
+    w->format = format;
+    w->width = width;
+    w->height = height;
+    w->row_size = row_size;
+
+    int ok = 1;
+    if (writer_indexed(w)) {
+        w->counting = 1;
+        w->color_capacity = 1024;
+        w->color_keys = calloc(w->color_capacity, sizeof(uint32_t));
+        w->color_counts = calloc(w->color_capacity, sizeof(uint32_t));
+        w->color_index = calloc(w->color_capacity, 1);
+        w->line = malloc(width + 4);
+        w->encoded = malloc((size_t)width * 2 + 16);
+        ok = w->color_keys && w->color_counts && w->color_index && w->line && w->encoded;
+    } else if (format == GANTT_IMAGE_PNG) {
+        w->line = malloc((size_t)width * 3 + 1);
+        w->encoded = calloc((size_t)width * 3, 1);
+        ok = w->line && w->encoded;
+    }
+
+    w->f = ok ? fopen(filename, "wb") : NULL;
+    if (!w->f) {
+        if (ok) printf("Erro: Não foi possível criar o arquivo %s\n", filename);
+        else printf("Erro: Não foi possível alocar memória para a imagem.\n");
+        writer_free(w);
+        return 0;
+    }
+
+    if (format == GANTT_IMAGE_PNG) {
+        static const uint8_t signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+        uint8_t ihdr[13];
+        put_be32(ihdr, width);
+        put_be32(ihdr + 4, height);
+        ihdr[8] = 8;    /* 8 bits por amostra */
+        ihdr[9] = 2;    /* RGB */
+        ihdr[10] = 0;   /* deflate */
+        ihdr[11] = 0;   /* filtros padrão */
+        ihdr[12] = 0;   /* sem entrelaçamento */
+
+        fwrite(signature, 1, sizeof(signature), w->f);
+        png_write_chunk(w->f, "IHDR", ihdr, sizeof(ihdr));
+        if (!deflate_init(&w->z, png_write_idat, w->f)) {
+            printf("Erro: Não foi possível alocar memória para a imagem.\n");
+            fclose(w->f);
+            writer_free(w);
+            return 0;
+        }
+    } else {
+        size_t pixel_bytes = (format == GANTT_IMAGE_BMP24) ? (size_t)row_size * height
+                           : (size_t)((width + 3) & ~3) * height;
+        bmp_write_headers(w, pixel_bytes);
+    }
+    return 1;
+}
+
+/**
+ * Grava uma linha de pixels BGR no formato do gravador
+ */
+static void writer_row(ImageWriter* w, const uint8_t* bgr) {
+    switch (w->format) {
+        case GANTT_IMAGE_BMP24:
+            fwrite(bgr, 1, w->row_size, w->f);
+            break;
+
+        case GANTT_IMAGE_BMP8: {
+            int padded = (w->width + 3) & ~3;
+            writer_index_row(w, bgr);
+            memset(w->line + w->width, 0, padded - w->width);
+            fwrite(w->line, 1, padded, w->f);
+            break;
+        }
+
+        case GANTT_IMAGE_RLE8: {
+            writer_index_row(w, bgr);
+            size_t n = rle8_encode_row(w->line, w->width, w->encoded);
+            fwrite(w->encoded, 1, n, w->f);
+            w->pixel_bytes += n;
+            break;
+        }
+
+        case GANTT_IMAGE_PNG: {
+            /* Filtro "Up": diferença para a linha de cima (áreas lisas viram
+             * zeros, que o deflate comprime em repetições longas) */
+            uint8_t* prev = w->encoded;
+            w->line[0] = 2;
+            for (int x = 0; x < w->width; x++) {
+                const uint8_t* p = bgr + x * 3;
+                uint8_t rgb[3] = {p[2], p[1], p[0]};
+                for (int c = 0; c < 3; c++) {
+                    w->line[1 + x * 3 + c] = (uint8_t)(rgb[c] - prev[x * 3 + c]);
+                    prev[x * 3 + c] = rgb[c];
+                }
+            }
+            deflate_write(&w->z, w->line, (size_t)w->width * 3 + 1);
+            break;
+        }
+    }
+}
+
+/**
+ * Grava as linhas de uma faixa na ordem do arquivo (ou, na contagem de
+ * cores, só as conta)
+ */
+static void writer_band(ImageWriter* w, const BmpCanvas* cv) {
+    int rows = cv->y1 - cv->y0;
+    for (int i = 0; i < rows; i++) {
+        int r = writer_bottom_up(w) ? rows - 1 - i : i;
+        const uint8_t* bgr = cv->data + (size_t)r * cv->row_size;
+        if (w->counting) count_row(w, bgr);
+        else writer_row(w, bgr);
+    }
+}
+
+/**
+ * Fim da contagem de cores: monta a paleta para a gravação
+ */
+static void writer_end_count(ImageWriter* w) {
+    w->counting = 0;
+    if (w->failed || !writer_build_palette(w)) w->failed = 1;
+}
+
+/**
+ * Fecha o arquivo, completando cabeçalhos e paleta; retorna 0 em erro
+ */
+static int writer_close(ImageWriter* w) {
+    if (w->format == GANTT_IMAGE_PNG) {
+        deflate_finish(&w->z);
+        png_write_chunk(w->f, "IEND", NULL, 0);
+    } else if (writer_indexed(w)) {
+        size_t pixel_bytes = (size_t)((w->width + 3) & ~3) * w->height;
+        if (w->format == GANTT_IMAGE_RLE8) {
+            /* Fim da imagem */
+            uint8_t end[2] = {0, 1};
+            fwrite(end, 1, 2, w->f);
+            pixel_bytes = w->pixel_bytes + 2;
+        }
+        fseek(w->f, 0, SEEK_SET);
+        bmp_write_headers(w, pixel_bytes);
+
+        if (w->palette_reduced) {
+            printf("Aviso: %lu cores na imagem; paleta reduzida a %d cores.\n",
+                   (unsigned long)w->color_count, PALETTE_SIZE);
+        }
+    }
+
+    int ok = !w->failed && !ferror(w->f);
+    ok = (fclose(w->f) == 0) && ok;
+    writer_free(w);
+    return ok;
+}
+
+/* ============================================================================
+ * FUNÇÃO PÚBLICA DE GERAÇÃO DO GRÁFICO DE GANTT
+ * ============================================================================ */
+
+/* Linhas de pixels rasterizadas de cada vez: a memória de pico não depende
+ * da altura da imagem */
+#define BMP_BAND_ROWS   64
+
+/* Threads de rasterização: no máximo BMP_MAX_THREADS, e só para imagens
+ * com pelo menos BMP_THREAD_MIN_BYTES de pixels (abaixo disso criar as
+ * threads custa mais que desenhar) */
+#define BMP_MAX_THREADS         8
+#define BMP_THREAD_MIN_BYTES    (4 * 1024 * 1024)
+
+/* Uma faixa a rasterizar por uma thread */
+typedef struct {
+    BmpCanvas canvas;
+    const GanttLayout* layout;
+} BandJob;
+
+static void* band_worker(void* arg) {
+    BandJob* job = (BandJob*)arg;
+    render_band(&job->canvas, job->layout);
+    return NULL;
+}
+
+/**
+ * Número de threads para uma imagem de 'bytes' bytes de pixels
+ */
+static int bmp_thread_count(const GanttBmpOptions* options, size_t bytes) {
+    int threads = options->threads;
+
+    if (threads <= 0) {
+        if (bytes < BMP_THREAD_MIN_BYTES) return 1;
+        long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = (cpus > 0) ? (int)cpus : 1;
+    }
+    return (threads < BMP_MAX_THREADS) ? threads : BMP_MAX_THREADS;
+}
+
+/**
+ * Rasteriza a imagem inteira, faixa a faixa, entregando as faixas ao
+ * gravador. A cada rodada, cada thread rasteriza uma faixa no seu buffer (a
+ * primeira fica com a thread atual) e as faixas são entregues na ordem do
+ * arquivo: de cima para baixo, ou de baixo para cima no RLE8. As faixas não
+ * se sobrepõem e o layout é só lido, então não há disputa por pixels.
+ */
+static void render_bands(const GanttLayout* L, uint8_t* band, int band_rows, int threads,
+                         ImageWriter* writer) {
+    size_t band_bytes = (size_t)writer->row_size * band_rows;
+    int band_count = (L->height + band_rows - 1) / band_rows;
+
+    for (int first = 0; first < band_count; first += threads) {
+        BandJob jobs[BMP_MAX_THREADS];
+        pthread_t workers[BMP_MAX_THREADS];
+        int started[BMP_MAX_THREADS] = {0};
+        int n = 0;
+
+        for (int k = 0; k < threads && first + k < band_count; k++, n++) {
+            int b = writer_bottom_up(writer) ? band_count - 1 - (first + k) : first + k;
+            int y0 = b * band_rows;
+            BmpCanvas cv = {band + k * band_bytes, writer->row_size, L->width, L->height, y0,
+                            (y0 + band_rows < L->height) ? y0 + band_rows : L->height};
+            jobs[k].canvas = cv;
+            jobs[k].layout = L;
+        }
+
+        for (int k = 1; k < n; k++) {
+            started[k] = (pthread_create(&workers[k], NULL, band_worker, &jobs[k]) == 0);
+        }
+        for (int k = 0; k < n; k++) {
+            /* Sem thread (a primeira ou se a criação falhou): desenhar aqui */
+            if (!started[k]) band_worker(&jobs[k]);
+        }
+        for (int k = 1; k < n; k++) {
+            if (started[k]) pthread_join(workers[k], NULL);
+        }
+
+        for (int k = 0; k < n; k++) {
+            writer_band(writer, &jobs[k].canvas);
+        }
+    }
+}
+
+void create_gantt_bmp(const char* filename, GanttEntry* entries, int entry_count,
+                      int total_time, int task_count, const GanttPalette* palette) {
+    create_gantt_bmp_ex(filename, entries, entry_count, total_time, task_count, palette, NULL);
+}
+
+void create_gantt_bmp_ex(const char* filename, GanttEntry* entries, int entry_count,
+                         int total_time, int task_count, const GanttPalette* palette,
+                         const GanttBmpOptions* options) {
+
+    GanttBmpOptions defaults = {0};
+    if (!options) options = &defaults;
+
+    GanttLayout L;
+    memset(&L, 0, sizeof(GanttLayout));
+    L.entries = entries;
+    L.entry_count = entry_count;
+    L.palette = palette;
+    L.options = options;
+    L.total_time = total_time;
+    L.task_count = task_count;
+
+    /* Há perdas de prazo? (reserva a faixa de linha do tempo) */
+    for (int i = 0; i < options->marker_count; i++) {
+        if (options->markers[i].kind == GANTT_MARK_MISS) L.has_misses = 1;
+    }
+
+    /* Há overhead de troca? (reserva a linha "CS" abaixo das tarefas) */
+    for (int i = 0; i < entry_count; i++) {
+        if (entries[i].task_id == GANTT_OVERHEAD_ID) {
+            L.has_overhead = 1;
+            break;
+        }
+    }
+    L.row_count = task_count + L.has_overhead;
+
+    /* Calcular dimensões */
+    int time_scale = MIN_TICK_WIDTH;
+    long long full_width = MARGIN_LEFT + (long long)total_time * time_scale + MARGIN_RIGHT;
+
+    /* Largura acima do limite: agrupar ticks em colunas (nível de detalhe) */
+    int lod = (options->max_width > 0 && full_width > options->max_width);
+    int width = lod ? options->max_width : (int)full_width;
+    if (width < 400) width = 400;
+
+    L.chart_height = L.row_count * (ROW_HEIGHT + ROW_SPACING);
+    int height = MARGIN_TOP + L.chart_height + MARGIN_BOTTOM;
+    if (L.has_misses) height += MISS_STRIP_HEIGHT;
+    if (height < 200) height = 200;
+    L.width = width;
+    L.height = height;
+    L.strip_y = L.has_misses ? MARGIN_TOP + L.chart_height + 4 : -1;
+
+    time_scale = (width - MARGIN_LEFT - MARGIN_RIGHT) / (total_time > 0 ? total_time : 1);
+    if (time_scale < MIN_TICK_WIDTH) time_scale = MIN_TICK_WIDTH;
+
+    TimeAxis axis = {time_scale, width - MARGIN_LEFT - MARGIN_RIGHT,
+                     total_time > 0 ? total_time : 1, lod};
+    L.axis = axis;
+
+    /* Alocar uma faixa de linhas por thread (não a imagem inteira) */
+    int padding = (4 - (width * 3) % 4) % 4;
+    int row_size = width * 3 + padding;
+    int threads = bmp_thread_count(options, (size_t)row_size * height);
+    int band_rows = (height + threads - 1) / threads;
+    if (band_rows > BMP_BAND_ROWS) band_rows = BMP_BAND_ROWS;
+    size_t band_bytes = (size_t)row_size * band_rows;
+
+    uint8_t* band = calloc(band_bytes * threads, 1);
+    if (!band || !layout_row_colors(&L) || !layout_index_rows(&L) ||
+        (lod && !layout_lod_coverage(&L))) {
+        printf("Erro: Não foi possível alocar memória para a imagem.\n");
+        free(band);
+        layout_free(&L);
         return;
     }
 
-    fwrite(&file_header, sizeof(BMPFileHeader), 1, f);
-    fwrite(&info_header, sizeof(BMPInfoHeader), 1, f);
-    fwrite(image, 1, row_size * height, f);
+    /* Escrever arquivo */
+    ImageWriter writer;
+    if (!writer_open(&writer, filename, options->format, width, height, row_size)) {
+        free(band);
+        layout_free(&L);
+        return;
+    }
 
-    fclose(f);
-    free(image);
+    /* Formatos com paleta: uma passada para contar as cores, outra para
+     * gravar (desenhar de novo custa menos que guardar a imagem inteira) */
+    if (writer_indexed(&writer)) {
+        render_bands(&L, band, band_rows, threads, &writer);
+        writer_end_count(&writer);
+    }
+    if (!writer.failed) {
+        render_bands(&L, band, band_rows, threads, &writer);
+    }
+
+    int ok = writer_close(&writer);
+    free(band);
+    layout_free(&L);
 
+    if (!ok) {
+        printf("Erro: Falha ao gravar o arquivo %s\n", filename);
+        return;
+    }
     printf("Gráfico de Gantt salvo em: %s (%dx%d pixels)\n", filename, width, height);
-}
\ No newline at end of file
+}
@@ -9,17 +9,64 @@
 #define GANTT_BMP_H
 
 #include <stdint.h>
+#include "gantt_palette.h"  /* Cores das linhas (GanttPalette) */
 
 /* Estrutura que representa uma entrada no gráfico de Gantt.
  * Cada entrada corresponde a um período contínuo de execução de uma tarefa.
+ * A cor não fica na entrada: é a da linha da tarefa na GanttPalette, que
+ * também tem o id da tarefa mostrado no rótulo da linha.
  */
 typedef struct {
-    int task_id;        /* ID da tarefa */
+    int task_id;        /* Linha da tarefa no gráfico (0 a task_count - 1) */
     int start_time;     /* Tick de início da execução */
     int end_time;       /* Tick de fim da execução */
-    char color[8];      /* Cor em hexadecimal (#RRGGBB) */
 } GanttEntry;
 
+/* task_id usado nas entradas de overhead de troca de contexto.
+ * Essas entradas são desenhadas em uma linha extra "CS" abaixo das tarefas.
+ */
+#define GANTT_OVERHEAD_ID   (-1)
+
+/* Tipos de marcador que podem ser sobrepostos ao gráfico */
+typedef enum {
+    GANTT_MARK_DEADLINE,    /* Prazo absoluto de uma tarefa */
+    GANTT_MARK_MISS         /* Prazo perdido (tarefa terminou depois dele) */
+} GanttMarkKind;
+
+/* Marcador pontual na linha de uma tarefa (ex.: prazo) */
+typedef struct {
+    int task_id;            /* Linha da tarefa no gráfico */
+    int time;               /* Instante marcado */
+    GanttMarkKind kind;     /* Tipo do marcador */
+} GanttMarker;
+
+/* Formato do arquivo de imagem */
+typedef enum {
+    GANTT_IMAGE_BMP24,      /* BMP de 24 bits sem compressão (padrão) */
+    GANTT_IMAGE_BMP8,       /* BMP de 8 bits com paleta */
+    GANTT_IMAGE_RLE8,       /* BMP de 8 bits comprimido (BI_RLE8) */
+    GANTT_IMAGE_PNG         /* PNG RGB (compressão deflate própria) */
+} GanttImageFormat;
+
+/* Opções adicionais da geração do BMP (todas opcionais) */
+typedef struct {
+    const GanttMarker* markers; /* Marcadores de prazo (NULL = nenhum) */
+    int marker_count;           /* Número de marcadores */
+    int max_width;              /* Largura máxima da imagem (0 = sem limite).
+                                 * Se o gráfico não couber, os ticks são
+                                 * agrupados em colunas de pixels (nível de
+                                 * detalhe) e cada coluna mostra a ocupação
+                                 * de cada tarefa como um tom da sua cor. */
+    int threads;                /* Threads de rasterização (0 = automático:
+                                 * uma por processador em imagens grandes,
+                                 * 1 = sem threads). A imagem é a mesma
+                                 * qualquer que seja o número. */
+    GanttImageFormat format;    /* Formato do arquivo. Nos formatos de 8
+                                 * bits, se houver mais de 256 cores (nível
+                                 * de detalhe), as excedentes usam a cor
+                                 * mais próxima da paleta. */
+} GanttBmpOptions;
+
 /* Gera um arquivo BMP com o gráfico de Gantt.
  *
  * @param filename     Nome do arquivo de saída
@@ -27,8 +74,19 @@ typedef struct {
  * @param entry_count  Número de entradas no array
  * @param total_time   Tempo total da simulação (eixo X)
  * @param task_count   Número total de tarefas (eixo Y)
+ * @param palette      Cores e rótulos das linhas (task_count linhas mais o overhead)
  */
 void create_gantt_bmp(const char* filename, GanttEntry* entries, int entry_count,
-                      int total_time, int task_count);
+                      int total_time, int task_count, const GanttPalette* palette);
+
+/* Igual a create_gantt_bmp, com opções adicionais.
+ * Se houver marcadores de perda de prazo, uma faixa "MISS" com a linha do
+ * tempo das perdas é desenhada abaixo das tarefas.
+ *
+ * @param options  Opções adicionais (NULL = padrão)
+ */
+void create_gantt_bmp_ex(const char* filename, GanttEntry* entries, int entry_count,
+                         int total_time, int task_count, const GanttPalette* palette,
+                         const GanttBmpOptions* options);
 
 #endif /* GANTT_BMP_H */
\ No newline at end of file
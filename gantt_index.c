@@ -0,0 +1,124 @@
+/*
+ * gantt_index.c - Índice de intervalos sobre as entradas do Gantt
+ * ---------------------------------------------------------------
+ * Cada sub-lista é um vetor que dobra de tamanho quando enche. Como o
+ * registro só cresce no fim e só é truncado no fim, as entradas
+ * descartadas por gantt_index_truncate estão sempre no final das
+ * sub-listas. As consultas são buscas binárias pelo fim das entradas, que
+ * cresce junto com o início.
+ *
+ * NOTA: Todas as funções auxiliares são marcadas como 'static'
+ * para evitar conflitos com outros módulos.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "gantt_index.h"
+
+/* ============================================================================
+ * FUNÇÕES AUXILIARES (STATIC - locais ao arquivo)
+ * ============================================================================ */
+
+static int row_push(GanttIndexRow* row, int i) {
+    if (row->count == row->capacity) {
+        int capacity = (row->capacity > 0) ? row->capacity * 2 : 16;
+        int* items = realloc(row->items, capacity * sizeof(int));
+        if (!items) return 0;
+        row->items = items;
+        row->capacity = capacity;
+    }
+    row->items[row->count++] = i;
+    return 1;
+}
+
+/* ============================================================================
+ * FUNÇÕES PÚBLICAS
+ * ============================================================================ */
+
+void gantt_index_init(GanttIndex* index) {
+    memset(index, 0, sizeof(GanttIndex));
+}
+
+int gantt_index_reset(GanttIndex* index, int row_count) {
+    if (row_count + 1 > index->row_capacity) {
+        GanttIndexRow* rows = realloc(index->rows, (row_count + 1) * sizeof(GanttIndexRow));
+        if (!rows) return 0;
+        memset(rows + index->row_capacity, 0,
+               (row_count + 1 - index->row_capacity) * sizeof(GanttIndexRow));
+        index->rows = rows;
+        index->row_capacity = row_count + 1;
+    }
+
+    index->row_count = row_count;
+    for (int r = 0; r < index->row_capacity; r++) {
+        index->rows[r].count = 0;
+    }
+    return 1;
+}
+
+int gantt_index_build(GanttIndex* index, const GanttEntry* entries, int entry_count,
+                      int row_count) {
+    if (!gantt_index_reset(index, row_count)) return 0;
+
+    /* Contar antes para alocar cada sub-lista uma única vez */
+    for (int i = 0; i < entry_count; i++) {
+        int row = gantt_index_row_of(index, &entries[i]);
+        if (row >= 0) index->rows[row].count++;
+    }
+    for (int r = 0; r <= row_count; r++) {
+        GanttIndexRow* row = &index->rows[r];
+        if (row->count > row->capacity) {
+            int* items = realloc(row->items, row->count * sizeof(int));
+            if (!items) return 0;
+            row->items = items;
+            row->capacity = row->count;
+        }
+        row->count = 0;
+    }
+
+    for (int i = 0; i < entry_count; i++) {
+        int row = gantt_index_row_of(index, &entries[i]);
+        if (row >= 0) index->rows[row].items[index->rows[row].count++] = i;
+    }
+    return 1;
+}
+
+int gantt_index_append(GanttIndex* index, const GanttEntry* entries, int i) {
+    int row = gantt_index_row_of(index, &entries[i]);
+    return (row < 0) ? 1 : row_push(&index->rows[row], i);
+}
+
+void gantt_index_truncate(GanttIndex* index, int count) {
+    for (int r = 0; r <= index->row_count; r++) {
+        GanttIndexRow* row = &index->rows[r];
+        while (row->count > 0 && row->items[row->count - 1] >= count) {
+            row->count--;
+        }
+    }
+}
+
+void gantt_index_free(GanttIndex* index) {
+    for (int r = 0; r < index->row_capacity; r++) {
+        free(index->rows[r].items);
+    }
+    free(index->rows);
+    memset(index, 0, sizeof(GanttIndex));
+}
+
+int gantt_index_row_of(const GanttIndex* index, const GanttEntry* entry) {
+    if (entry->task_id == GANTT_OVERHEAD_ID) return index->row_count;
+    return (entry->task_id >= 0 && entry->task_id < index->row_count) ? entry->task_id : -1;
+}
+
+int gantt_index_row_lower(const GanttIndex* index, const GanttEntry* entries,
+                          int row, int t) {
+    const GanttIndexRow* list = &index->rows[row];
+    int lo = 0;
+    int hi = list->count;
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (entries[list->items[mid]].end_time <= t) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
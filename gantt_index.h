@@ -0,0 +1,66 @@
+/*
+ * gantt_index.h - Índice de intervalos sobre as entradas do Gantt
+ *
+ * As entradas do Gantt estão em ordem cronológica e não se sobrepõem (uma
+ * CPU). O índice guarda, para cada linha do gráfico, a sub-lista dos
+ * índices das suas entradas, também em ordem de tempo, e uma busca binária
+ * na sub-lista responde "quais entradas da tarefa cruzam [t0, t1)". O
+ * quadro do modo debug, o Gantt ASCII e o BMP agrupam as entradas por
+ * linha com ele. As linhas são as tarefas 0..row_count-1
+ * e mais uma (row_count) para o overhead de troca de contexto ("CS").
+ *
+ * O índice pode ser montado de uma vez (gantt_index_build) ou mantido junto
+ * com um registro que cresce (gantt_index_append) e volta no tempo
+ * (gantt_index_truncate). Só guarda posições: estender a última entrada
+ * não exige atualização.
+ */
+
+#ifndef GANTT_INDEX_H
+#define GANTT_INDEX_H
+
+#include "gantt_bmp.h"  /* Para usar GanttEntry */
+
+/* Sub-lista de uma linha: índices das entradas em ordem de tempo */
+typedef struct {
+    int* items;
+    int count;
+    int capacity;
+} GanttIndexRow;
+
+typedef struct {
+    int row_count;              /* Linhas de tarefas (a seguinte é a "CS") */
+    GanttIndexRow* rows;        /* row_count + 1 sub-listas */
+    int row_capacity;           /* Sub-listas alocadas */
+} GanttIndex;
+
+/* Prepara um índice vazio */
+void gantt_index_init(GanttIndex* index);
+
+/* Esvazia o índice para row_count linhas, mantendo a memória das
+ * sub-listas (retorna 0 se faltar memória) */
+int gantt_index_reset(GanttIndex* index, int row_count);
+
+/* Monta o índice de uma lista inteira (retorna 0 se faltar memória) */
+int gantt_index_build(GanttIndex* index, const GanttEntry* entries, int entry_count,
+                      int row_count);
+
+/* Acrescenta a entrada entries[i], a mais nova do registro
+ * (retorna 0 se faltar memória) */
+int gantt_index_append(GanttIndex* index, const GanttEntry* entries, int i);
+
+/* Esquece as entradas de índice >= count (registro truncado) */
+void gantt_index_truncate(GanttIndex* index, int count);
+
+/* Libera a memória do índice */
+void gantt_index_free(GanttIndex* index);
+
+/* Linha de uma entrada (-1 se não pertence a nenhuma) */
+int gantt_index_row_of(const GanttIndex* index, const GanttEntry* entry);
+
+/* Posição, na sub-lista de row, da primeira entrada que termina depois
+ * de t (o tamanho da sub-lista se nenhuma). As entradas da linha que
+ * cruzam [t0, t1) vão dela até a primeira com início >= t1. */
+int gantt_index_row_lower(const GanttIndex* index, const GanttEntry* entries,
+                          int row, int t);
+
+#endif /* GANTT_INDEX_H */
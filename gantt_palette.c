@@ -0,0 +1,95 @@
+/*
+ * gantt_palette.c - Paleta de cores das linhas do Gantt
+ * -----------------------------------------------------
+ * O código ANSI segue o mapeamento que o Gantt ASCII e o modo debug já
+ * usavam: as seis cores primárias e secundárias puras têm o código próprio
+ * e as demais ficam brancas.
+ *
+ * NOTA: Todas as funções auxiliares são marcadas como 'static'
+ * para evitar conflitos com outros módulos.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "gantt_palette.h"
+
+#define PALETTE_DEFAULT_HEX "#808080"
+
+/* ============================================================================
+ * FUNÇÕES AUXILIARES (STATIC - locais ao arquivo)
+ * ============================================================================ */
+
+static const char* palette_ansi(const char* hex) {
+    if (strstr(hex, "FF0000") || strstr(hex, "ff0000")) return "\033[31m";
+    if (strstr(hex, "00FF00") || strstr(hex, "00ff00")) return "\033[32m";
+    if (strstr(hex, "0000FF") || strstr(hex, "0000ff")) return "\033[34m";
+    if (strstr(hex, "FFFF00") || strstr(hex, "ffff00")) return "\033[33m";
+    if (strstr(hex, "FF00FF") || strstr(hex, "ff00ff")) return "\033[35m";
+    if (strstr(hex, "00FFFF") || strstr(hex, "00ffff")) return "\033[36m";
+    return "\033[37m";
+}
+
+static void palette_parse(GanttColor* color, const char* hex) {
+    strncpy(color->hex, hex, sizeof(color->hex) - 1);
+    color->hex[sizeof(color->hex) - 1] = '\0';
+    color->ansi = palette_ansi(color->hex);
+
+    unsigned int value;
+    const char* digits = (hex[0] == '#') ? hex + 1 : hex;
+    if (sscanf(digits, "%06x", &value) != 1) value = 0;
+    color->r = (value >> 16) & 0xFF;
+    color->g = (value >> 8) & 0xFF;
+    color->b = value & 0xFF;
+}
+
+/* ============================================================================
+ * FUNÇÕES PÚBLICAS
+ * ============================================================================ */
+
+void gantt_palette_init(GanttPalette* palette) {
+    memset(palette, 0, sizeof(GanttPalette));
+}
+
+int gantt_palette_reset(GanttPalette* palette, int row_count) {
+    if (row_count + 1 > palette->capacity) {
+        GanttColor* colors = realloc(palette->colors, (row_count + 1) * sizeof(GanttColor));
+        if (colors) palette->colors = colors;
+        int* labels = realloc(palette->labels, (row_count + 1) * sizeof(int));
+        if (labels) palette->labels = labels;
+        if (!colors || !labels) return 0;
+        palette->capacity = row_count + 1;
+    }
+
+    palette->row_count = row_count;
+    for (int r = 0; r <= row_count; r++) {
+        palette_parse(&palette->colors[r], PALETTE_DEFAULT_HEX);
+        palette->labels[r] = r;
+    }
+    return 1;
+}
+
+void gantt_palette_set(GanttPalette* palette, int row, const char* hex) {
+    if (row < 0 || row > palette->row_count) return;
+    palette_parse(&palette->colors[row], hex);
+}
+
+void gantt_palette_set_label(GanttPalette* palette, int row, int label) {
+    if (row < 0 || row >= palette->row_count) return;
+    palette->labels[row] = label;
+}
+
+int gantt_palette_label(const GanttPalette* palette, int row) {
+    return (row >= 0 && row < palette->row_count) ? palette->labels[row] : row;
+}
+
+const GanttColor* gantt_palette_color(const GanttPalette* palette, int task_id) {
+    int row = (task_id >= 0 && task_id < palette->row_count) ? task_id : palette->row_count;
+    return &palette->colors[row];
+}
+
+void gantt_palette_free(GanttPalette* palette) {
+    free(palette->colors);
+    free(palette->labels);
+    memset(palette, 0, sizeof(GanttPalette));
+}
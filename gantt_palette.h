@@ -0,0 +1,56 @@
+/*
+ * gantt_palette.h - Paleta de cores das linhas do Gantt
+ *
+ * A cor de cada linha do gráfico (tarefa, tarefa periódica e a linha "CS"
+ * do overhead) é interpretada uma única vez, quando a paleta é montada:
+ * RGB para as imagens, o texto "#RRGGBB" para o SVG e o código ANSI mais
+ * próximo para o terminal. As entradas do Gantt guardam só a linha, e os
+ * renderizadores buscam a cor aqui em vez de analisar texto a cada entrada.
+ *
+ * A paleta também guarda o rótulo de cada linha ("T<n>"): o id da tarefa
+ * na configuração, que pode ser qualquer número (um PID, por exemplo).
+ * Sem rótulo definido, a linha r mostra r.
+ */
+
+#ifndef GANTT_PALETTE_H
+#define GANTT_PALETTE_H
+
+#include <stdint.h>
+
+typedef struct {
+    uint8_t r, g, b;            /* Cor já convertida */
+    char hex[8];                /* Como escrita na configuração ("#RRGGBB") */
+    const char* ansi;           /* Sequência ANSI da cor do texto */
+} GanttColor;
+
+typedef struct {
+    int row_count;              /* Linhas de tarefas (a seguinte é a "CS") */
+    GanttColor* colors;         /* row_count + 1 cores */
+    int* labels;                /* Número mostrado em cada linha */
+    int capacity;               /* Cores e rótulos alocados */
+} GanttPalette;
+
+/* Prepara uma paleta vazia */
+void gantt_palette_init(GanttPalette* palette);
+
+/* Ajusta a paleta para row_count linhas, todas cinza e com o próprio
+ * número como rótulo (retorna 0 se faltar memória) */
+int gantt_palette_reset(GanttPalette* palette, int row_count);
+
+/* Define a cor da linha row (row_count = overhead) a partir de "#RRGGBB" */
+void gantt_palette_set(GanttPalette* palette, int row, const char* hex);
+
+/* Define o rótulo da linha row (0 a row_count - 1) */
+void gantt_palette_set_label(GanttPalette* palette, int row, int label);
+
+/* Rótulo da linha row (fora das linhas de tarefas: o próprio row) */
+int gantt_palette_label(const GanttPalette* palette, int row);
+
+/* Cor das entradas de task_id; o overhead (GANTT_OVERHEAD_ID) e ids fora
+ * das linhas usam a cor da linha "CS" */
+const GanttColor* gantt_palette_color(const GanttPalette* palette, int task_id);
+
+/* Libera a memória da paleta */
+void gantt_palette_free(GanttPalette* palette);
+
+#endif /* GANTT_PALETTE_H */
@@ -0,0 +1,409 @@
+/*
+ * gantt_svg.c - Exportação do Gantt Chart em SVG / HTML
+ * -----------------------------------------------------
+ * O gráfico fica em um grupo escalado horizontalmente: dentro dele as
+ * coordenadas X são ticks inteiros (arquivo menor e sem arredondamento), e
+ * as linhas usam "vector-effect: non-scaling-stroke" para manter a
+ * espessura. Rótulos e legenda ficam fora do grupo, em pixels.
+ *
+ * Com a junção ativada, cada linha guarda uma execução pendente que vai
+ * sendo estendida pela próxima execução da mesma cor enquanto o conjunto
+ * couber em 1 pixel (ou se ela começar exatamente onde a pendente termina,
+ * sem buracos). Assim milhões de execuções curtas viram no máximo uma por
+ * pixel de largura, com opacidade proporcional à ocupação, como as colunas
+ * do BMP com nível de detalhe.
+ *
+ * NOTA: Todas as funções auxiliares são marcadas como 'static'
+ * para evitar conflitos com outros módulos.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "gantt_svg.h"
+#include "text_writer.h"
+
+/* ============================================================================
+ * CONSTANTES DE LAYOUT (as mesmas do BMP)
+ * ============================================================================ */
+
+#define SVG_MARGIN_LEFT     80
+#define SVG_MARGIN_RIGHT    20
+#define SVG_MARGIN_TOP      50
+#define SVG_MARGIN_BOTTOM   60
+#define SVG_ROW_HEIGHT      40
+#define SVG_ROW_SPACING     5
+#define SVG_BAR_HEIGHT      30
+#define SVG_TICK_WIDTH      15      /* Pixels por tick sem limite de largura */
+#define SVG_LABEL_MIN_PX    60      /* Distância mínima entre rótulos de tempo */
+#define SVG_LEGEND_SPACING  60      /* Largura de cada item da legenda */
+#define SVG_LEGEND_LINE     20      /* Altura de cada linha da legenda */
+
+#define SVG_COLOR_ALT_ROW   "#f5f8ff"
+
+/* ============================================================================
+ * ESTRUTURAS E FUNÇÕES AUXILIARES (STATIC - locais ao arquivo)
+ * ============================================================================ */
+
+/* Execução pendente de uma linha (junção de execuções curtas) */
+typedef struct {
+    int start, end;
+    long long busy;             /* Ticks executados dentro de [start, end) */
+    int active;
+} SvgRun;
+
+typedef struct {
+    TextWriter out;
+    int task_count;
+    int rows;                   /* task_count + linha "CS" (se houver) */
+    int total_time;
+    double scale;               /* Pixels por tick */
+    const char** row_colors;    /* Cor da classe de cada linha */
+    long rect_count;            /* Retângulos de execução gravados */
+} SvgContext;
+
+static int svg_row_y(int row) {
+    return SVG_MARGIN_TOP + row * (SVG_ROW_HEIGHT + SVG_ROW_SPACING);
+}
+
+/**
+ * Linha do gráfico de uma entrada (-1 se não pertence a nenhuma)
+ */
+static int svg_entry_row(const SvgContext* ctx, const GanttEntry* entry) {
+    if (entry->task_id == GANTT_OVERHEAD_ID) {
+        return (ctx->rows > ctx->task_count) ? ctx->task_count : -1;
+    }
+    return (entry->task_id >= 0 && entry->task_id < ctx->task_count) ? entry->task_id : -1;
+}
+
+/**
+ * Intervalo entre rótulos de tempo: 1, 2 ou 5 x 10^n, com pelo menos
+ * SVG_LABEL_MIN_PX pixels entre eles
+ */
+static int svg_label_interval(double scale, int total_time) {
+    long long step = 1;
+    for (;;) {
+        static const int mult[3] = {1, 2, 5};
+        for (int i = 0; i < 3; i++) {
+            long long interval = step * mult[i];
+            if (interval * scale >= SVG_LABEL_MIN_PX || interval >= total_time) {
+                return (int)interval;
+            }
+        }
+        step *= 10;
+    }
+}
+
+/**
+ * Nome da classe CSS de uma linha ("t3" ou "cs")
+ */
+static void svg_row_class(SvgContext* ctx, int row) {
+    if (row == ctx->task_count) {
+        tw_puts(&ctx->out, "cs");
+    } else {
+        tw_putc(&ctx->out, 't');
+        tw_int(&ctx->out, row);
+    }
+}
+
+/**
+ * Grava o retângulo de uma execução (coordenadas X em ticks). Execuções
+ * juntadas com buracos (busy < end - start) ficam mais claras.
+ */
+static void svg_bar(SvgContext* ctx, int row, int start, int end, long long busy) {
+    TextWriter* w = &ctx->out;
+    if (end <= start) return;
+
+    tw_puts(w, "<rect class=\"");
+    svg_row_class(ctx, row);
+    tw_puts(w, "\" x=\"");
+    tw_int(w, start);
+    tw_puts(w, "\" y=\"");
+    tw_int(w, svg_row_y(row) + (SVG_ROW_HEIGHT - SVG_BAR_HEIGHT) / 2);
+    tw_puts(w, "\" width=\"");
+    tw_int(w, end - start);
+    tw_puts(w, "\" height=\"");
+    tw_int(w, SVG_BAR_HEIGHT);
+    tw_putc(w, '"');
+
+    if (busy < end - start) {
+        tw_printf(w, " opacity=\"%.2f\"", 0.25 + 0.75 * busy / (end - start));
+    }
+    tw_puts(w, "/>\n");
+    ctx->rect_count++;
+}
+
+/**
+ * Grava as execuções, juntando as que cabem em 1 pixel se pedido
+ */
+static void svg_write_bars(SvgContext* ctx, const GanttEntry* entries, int entry_count,
+                           int merge) {
+    SvgRun* pending = merge ? calloc(ctx->rows, sizeof(SvgRun)) : NULL;
+    if (merge && !pending) merge = 0;  /* Sem memória: gravar sem juntar */
+
+    for (int i = 0; i < entry_count; i++) {
+        const GanttEntry* e = &entries[i];
+        int row = svg_entry_row(ctx, e);
+        if (row < 0) continue;
+
+        int duration = e->end_time - e->start_time;
+        if (!merge) {
+            svg_bar(ctx, row, e->start_time, e->end_time, duration);
+            continue;
+        }
+
+        SvgRun* run = &pending[row];
+        if (run->active && e->start_time >= run->end) {
+            int seamless = (e->start_time == run->end && run->busy == run->end - run->start);
+            int subpixel = (e->end_time - run->start) * ctx->scale <= 1.0;
+            if (seamless || subpixel) {
+                run->end = e->end_time;
+                run->busy += duration;
+                continue;
+            }
+        }
+        if (run->active) svg_bar(ctx, row, run->start, run->end, run->busy);
+        run->start = e->start_time;
+        run->end = e->end_time;
+        run->busy = duration;
+        run->active = 1;
+    }
+
+    for (int r = 0; merge && r < ctx->rows; r++) {
+        SvgRun* run = &pending[r];
+        if (run->active) svg_bar(ctx, r, run->start, run->end, run->busy);
+    }
+    free(pending);
+}
+
+/**
+ * Grava os marcadores de um tipo como um único caminho
+ */
+static void svg_write_markers(SvgContext* ctx, const GanttSvgOptions* options,
+                              GanttMarkKind kind, const char* css_class) {
+    TextWriter* w = &ctx->out;
+    int opened = 0;
+
+    for (int i = 0; i < options->marker_count; i++) {
+        const GanttMarker* m = &options->markers[i];
+        if (m->kind != kind || m->task_id < 0 || m->task_id >= ctx->task_count) continue;
+
+        if (!opened) {
+            tw_printf(w, "<path class=\"%s\" d=\"", css_class);
+            opened = 1;
+        }
+        tw_putc(w, 'M');
+        tw_int(w, m->time);
+        tw_putc(w, ' ');
+        tw_int(w, svg_row_y(m->task_id));
+        tw_putc(w, 'V');
+        tw_int(w, svg_row_y(m->task_id) + SVG_ROW_HEIGHT);
+    }
+    if (opened) tw_puts(w, "\"/>\n");
+}
+
+/**
+ * Grava as linhas verticais da grade de 'step' em 'step' ticks (exceto as
+ * múltiplas de 'skip', desenhadas em outro caminho)
+ */
+static void svg_write_grid(SvgContext* ctx, const char* css_class, int step, int skip) {
+    TextWriter* w = &ctx->out;
+    int y0 = SVG_MARGIN_TOP;
+    int y1 = svg_row_y(ctx->rows);
+
+    tw_printf(w, "<path class=\"%s\" d=\"", css_class);
+    for (long long t = 0; t <= ctx->total_time; t += step) {
+        if (skip > 0 && t % skip == 0) continue;
+        tw_putc(w, 'M');
+        tw_int(w, t);
+        tw_putc(w, ' ');
+        tw_int(w, y0);
+        tw_putc(w, 'V');
+        tw_int(w, y1);
+    }
+    tw_puts(w, "\"/>\n");
+}
+
+/* Início da página HTML (o SVG vem em seguida, dentro de #view) */
+static const char* html_head =
+    "<!DOCTYPE html>\n"
+    "<html>\n<head>\n<meta charset=\"utf-8\">\n<title>Gantt Chart</title>\n"
+    "<style>\n"
+    "body{margin:0;font-family:sans-serif}\n"
+    "#bar{position:sticky;top:0;left:0;background:#eee;padding:4px}\n"
+    "#view{overflow:auto}\n"
+    "</style>\n</head>\n<body>\n"
+    "<div id=\"bar\"><button onclick=\"zoom(2)\">+</button> "
+    "<button onclick=\"zoom(0.5)\">-</button> <span id=\"z\">1x</span></div>\n"
+    "<div id=\"view\">\n";
+
+/* Fim da página: zoom horizontal reescalando o grupo do gráfico e
+ * reposicionando os rótulos de tempo */
+static const char* html_tail =
+    "</div>\n<script>\n"
+    "var svg=document.querySelector('#view svg');\n"
+    "var chart=document.getElementById('chart');\n"
+    "var ticks=+svg.dataset.ticks,base=+svg.dataset.scale,z=1;\n"
+    "var ml=80,mr=20,h=+svg.getAttribute('height');\n"
+    "function zoom(f){\n"
+    "  z=Math.max(1,z*f);var px=base*z,w=Math.ceil(ml+ticks*px+mr);\n"
+    "  chart.setAttribute('transform','translate('+ml+',0) scale('+px+',1)');\n"
+    "  svg.setAttribute('width',w);svg.setAttribute('viewBox','0 0 '+w+' '+h);\n"
+    "  svg.querySelectorAll('text.tl').forEach(function(t){"
+    "t.setAttribute('x',ml+t.dataset.t*px);});\n"
+    "  document.getElementById('z').textContent=z+'x';\n"
+    "}\n"
+    "</script>\n</body>\n</html>\n";
+
+/* ============================================================================
+ * FUNÇÃO PÚBLICA
+ * ============================================================================ */
+
+void create_gantt_svg(const char* filename, const GanttEntry* entries, int entry_count,
+                      int total_time, int task_count, const GanttPalette* palette,
+                      const GanttSvgOptions* options) {
+    GanttSvgOptions defaults = {0};
+    if (!options) options = &defaults;
+
+    SvgContext ctx;
+    memset(&ctx, 0, sizeof(SvgContext));
+    ctx.task_count = task_count;
+    ctx.total_time = (total_time > 0) ? total_time : 1;
+
+    /* Há overhead de troca? (linha "CS" abaixo das tarefas) */
+    int has_overhead = 0;
+    for (int i = 0; i < entry_count; i++) {
+        if (entries[i].task_id == GANTT_OVERHEAD_ID) {
+            has_overhead = 1;
+            break;
+        }
+    }
+    ctx.rows = task_count + has_overhead;
+
+    /* Cor de cada linha, da paleta */
+    ctx.row_colors = malloc((ctx.rows > 0 ? ctx.rows : 1) * sizeof(const char*));
+    if (!ctx.row_colors) {
+        printf("Erro: Não foi possível alocar memória para o SVG.\n");
+        return;
+    }
+    for (int r = 0; r < ctx.rows; r++) {
+        int task_id = (r < task_count) ? r : GANTT_OVERHEAD_ID;
+        ctx.row_colors[r] = gantt_palette_color(palette, task_id)->hex;
+    }
+
+    /* Escala: 15 pixels por tick, ou o que couber na largura máxima */
+    ctx.scale = SVG_TICK_WIDTH;
+    int margins = SVG_MARGIN_LEFT + SVG_MARGIN_RIGHT;
+    if (options->max_width > margins &&
+        (double)ctx.total_time * SVG_TICK_WIDTH > options->max_width - margins) {
+        ctx.scale = (double)(options->max_width - margins) / ctx.total_time;
+    }
+    int chart_width = (int)(ctx.total_time * ctx.scale + 0.999);
+    int width = chart_width + margins;
+
+    int per_line = chart_width / SVG_LEGEND_SPACING;
+    if (per_line < 1) per_line = 1;
+    int legend_lines = (task_count + per_line - 1) / per_line;
+    int height = svg_row_y(ctx.rows) + SVG_MARGIN_BOTTOM;
+    if (legend_lines > 1) height += (legend_lines - 1) * SVG_LEGEND_LINE;
+
+    if (!tw_open(&ctx.out, filename)) {
+        printf("Erro: Não foi possível criar o arquivo %s\n", filename);
+        free(ctx.row_colors);
+        return;
+    }
+    TextWriter* w = &ctx.out;
+
+    /* Cabeçalho e estilos (uma classe de cor por linha) */
+    if (options->html) {
+        tw_puts(w, html_head);
+    } else {
+        tw_puts(w, "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n");
+    }
+    tw_printf(w, "<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"%d\" height=\"%d\" "
+                 "viewBox=\"0 0 %d %d\" font-family=\"monospace\" font-size=\"12\" "
+                 "data-ticks=\"%d\" data-scale=\"%.6g\">\n",
+              width, height, width, height, ctx.total_time, ctx.scale);
+    tw_puts(w, "<style>\n"
+               ".grid{stroke:#dcdcdc;fill:none}\n"
+               ".major{stroke:#b4b4b4;fill:none}\n"
+               ".dl{stroke:#960000;fill:none}\n"
+               ".miss{stroke:#e60000;fill:none;stroke-width:3}\n"
+               ".grid,.major,.dl,.miss{vector-effect:non-scaling-stroke}\n"
+               ".tl{text-anchor:middle}\n");
+    for (int r = 0; r < ctx.rows; r++) {
+        tw_putc(w, '.');
+        svg_row_class(&ctx, r);
+        tw_puts(w, "{fill:");
+        tw_puts(w, ctx.row_colors[r]);
+        tw_puts(w, "}\n");
+    }
+    tw_puts(w, "</style>\n");
+    tw_puts(w, "<rect width=\"100%\" height=\"100%\" fill=\"#fff\"/>\n");
+
+    /* Gráfico (X em ticks) */
+    tw_printf(w, "<g id=\"chart\" transform=\"translate(%d,0) scale(%.6g,1)\">\n",
+              SVG_MARGIN_LEFT, ctx.scale);
+
+    for (int r = 1; r < ctx.rows; r += 2) {
+        tw_printf(w, "<rect x=\"0\" y=\"%d\" width=\"%d\" height=\"%d\" fill=\"%s\"/>\n",
+                  svg_row_y(r), ctx.total_time, SVG_ROW_HEIGHT, SVG_COLOR_ALT_ROW);
+    }
+
+    int label_interval = svg_label_interval(ctx.scale, ctx.total_time);
+    int minor = (label_interval % 5 == 0) ? label_interval / 5
+              : (label_interval % 2 == 0) ? label_interval / 2 : 0;
+    if (minor > 0 && minor * ctx.scale >= 4.0) {
+        svg_write_grid(&ctx, "grid", minor, label_interval);
+    }
+    svg_write_grid(&ctx, "major", label_interval, 0);
+
+    tw_puts(w, "<path class=\"major\" d=\"");
+    for (int r = 0; r <= ctx.rows; r++) {
+        tw_printf(w, "M0 %dH%d", svg_row_y(r), ctx.total_time);
+    }
+    tw_puts(w, "\"/>\n");
+
+    svg_write_bars(&ctx, entries, entry_count, options->merge);
+    svg_write_markers(&ctx, options, GANTT_MARK_DEADLINE, "dl");
+    svg_write_markers(&ctx, options, GANTT_MARK_MISS, "miss");
+    tw_puts(w, "</g>\n");
+
+    /* Rótulos de tempo (reposicionados pelo zoom do HTML) */
+    for (long long t = 0; t <= ctx.total_time; t += label_interval) {
+        tw_printf(w, "<text class=\"tl\" x=\"%.2f\" y=\"%d\" data-t=\"%lld\">%lld</text>\n",
+                  SVG_MARGIN_LEFT + t * ctx.scale, SVG_MARGIN_TOP - 10, t, t);
+    }
+
+    /* Rótulos das tarefas */
+    for (int r = 0; r < ctx.rows; r++) {
+        int y = svg_row_y(r) + SVG_ROW_HEIGHT / 2 + 4;
+        if (r == task_count) tw_printf(w, "<text x=\"15\" y=\"%d\">CS</text>\n", y);
+        else tw_printf(w, "<text x=\"15\" y=\"%d\">T%d</text>\n", y, gantt_palette_label(palette, r));
+    }
+
+    /* Legenda */
+    int legend_y = svg_row_y(ctx.rows) + 15;
+    for (int i = 0; i < task_count; i++) {
+        int x = SVG_MARGIN_LEFT + (i % per_line) * SVG_LEGEND_SPACING;
+        int y = legend_y + (i / per_line) * SVG_LEGEND_LINE;
+        tw_puts(w, "<rect class=\"");
+        svg_row_class(&ctx, i);
+        tw_printf(w, "\" x=\"%d\" y=\"%d\" width=\"12\" height=\"12\"/>"
+                     "<text x=\"%d\" y=\"%d\">T%d</text>\n", x, y, x + 17, y + 11,
+                  gantt_palette_label(palette, i));
+    }
+
+    tw_puts(w, "</svg>\n");
+    if (options->html) tw_puts(w, html_tail);
+
+    int ok = tw_close(w);
+    free(ctx.row_colors);
+
+    if (!ok) {
+        printf("Erro: Falha ao gravar o arquivo %s\n", filename);
+        return;
+    }
+    printf("Gráfico de Gantt salvo em: %s (%d execuções, %ld retângulos)\n",
+           filename, entry_count, ctx.rect_count);
+}
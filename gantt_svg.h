@@ -0,0 +1,43 @@
+/*
+ * gantt_svg.h - Exportação do Gantt Chart em SVG / HTML
+ *
+ * Gera uma linha do tempo vetorial, que pode ser ampliada no navegador sem
+ * perder resolução. Cada GanttEntry vira um retângulo, escrito direto do
+ * array de entradas por um buffer (text_writer); o arquivo nunca é montado
+ * inteiro em memória.
+ */
+
+#ifndef GANTT_SVG_H
+#define GANTT_SVG_H
+
+#include "gantt_bmp.h"  /* Para usar GanttEntry e GanttMarker */
+
+/* Opções da exportação (todas opcionais) */
+typedef struct {
+    int html;                   /* 1 = página HTML com o SVG embutido e
+                                 * botões de zoom horizontal */
+    int max_width;              /* Largura máxima do gráfico em pixels
+                                 * (0 = sem limite, 15 pixels por tick) */
+    int merge;                  /* 1 = juntar execuções seguidas da mesma
+                                 * tarefa que cabem em 1 pixel, com opacidade
+                                 * pela ocupação (arquivos menores em
+                                 * simulações longas) */
+    const GanttMarker* markers; /* Marcadores de prazo (NULL = nenhum) */
+    int marker_count;           /* Número de marcadores */
+} GanttSvgOptions;
+
+/* Gera o arquivo SVG (ou HTML) com o gráfico de Gantt.
+ *
+ * @param filename     Nome do arquivo de saída
+ * @param entries      Array de entradas do Gantt
+ * @param entry_count  Número de entradas no array
+ * @param total_time   Tempo total da simulação (eixo X)
+ * @param task_count   Número total de tarefas (eixo Y)
+ * @param palette      Cores e rótulos das linhas
+ * @param options      Opções adicionais (NULL = padrão)
+ */
+void create_gantt_svg(const char* filename, const GanttEntry* entries, int entry_count,
+                      int total_time, int task_count, const GanttPalette* palette,
+                      const GanttSvgOptions* options);
+
+#endif /* GANTT_SVG_H */
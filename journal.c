@@ -0,0 +1,119 @@
+/*
+ * journal.c - Diário de desfazer (undo) em quadros
+ * ------------------------------------------------
+ * Os registros ficam em um único buffer crescente, alinhados em 8 bytes:
+ *
+ *   [cabeçalho do quadro][registro][bytes antigos][registro][...]...
+ *
+ * Dentro de um quadro, cada byte alterado aparece em no máximo um registro
+ * (o simulador compara a imagem do início do tick com a do fim), então a
+ * ordem em que os registros são desfeitos não importa.
+ *
+ * NOTA: Todas as funções auxiliares são marcadas como 'static'
+ * para evitar conflitos com outros módulos.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "journal.h"
+
+/* ============================================================================
+ * ESTRUTURAS E FUNÇÕES AUXILIARES (STATIC - locais ao arquivo)
+ * ============================================================================ */
+
+/* Cabeçalho de cada registro de alteração */
+typedef struct {
+    int kind;           /* Tipo do objeto (definido pelo usuário do diário) */
+    int index;          /* Índice do objeto */
+    int offset;         /* Deslocamento da faixa dentro do objeto */
+    int size;           /* Tamanho da faixa em bytes */
+} JournalRecord;
+
+/**
+ * Arredonda um tamanho para o próximo múltiplo de 8 (alinhamento)
+ */
+static size_t align8(size_t n) {
+    return (n + 7) & ~(size_t)7;
+}
+
+/**
+ * Garante espaço para mais 'extra' bytes no buffer
+ */
+static void journal_reserve(Journal* j, size_t extra) {
+    if (j->size + extra <= j->capacity) return;
+
+    size_t new_capacity = (j->capacity > 0) ? j->capacity : 4096;
+    while (new_capacity < j->size + extra) new_capacity *= 2;
+
+    j->data = realloc(j->data, new_capacity);
+    j->capacity = new_capacity;
+}
+
+/* ============================================================================
+ * FUNÇÕES PÚBLICAS
+ * ============================================================================ */
+
+void journal_init(Journal* j, size_t header_size) {
+    memset(j, 0, sizeof(Journal));
+    j->header_size = header_size;
+}
+
+void journal_free(Journal* j) {
+    free(j->data);
+    free(j->frames);
+    memset(j, 0, sizeof(Journal));
+}
+
+void journal_clear(Journal* j) {
+    j->size = 0;
+    j->frame_count = 0;
+}
+
+void journal_begin_frame(Journal* j, const void* header) {
+    if (j->frame_count >= j->frame_capacity) {
+        j->frame_capacity = (j->frame_capacity > 0) ? j->frame_capacity * 2 : 256;
+        j->frames = realloc(j->frames, j->frame_capacity * sizeof(size_t));
+    }
+
+    size_t stride = align8(j->header_size);
+    journal_reserve(j, stride);
+    j->frames[j->frame_count++] = j->size;
+    memset(j->data + j->size, 0, stride);
+    memcpy(j->data + j->size, header, j->header_size);
+    j->size += stride;
+}
+
+void journal_record(Journal* j, int kind, int index, int offset,
+                    const void* old, int size) {
+    if (j->frame_count == 0 || size <= 0) return;
+
+    size_t total = sizeof(JournalRecord) + align8(size);
+    journal_reserve(j, total);
+
+    JournalRecord rec = {kind, index, offset, size};
+    memcpy(j->data + j->size, &rec, sizeof(JournalRecord));
+    memcpy(j->data + j->size + sizeof(JournalRecord), old, size);
+    j->size += total;
+}
+
+const void* journal_frame_header(const Journal* j, int frame) {
+    if (frame < 0 || frame >= j->frame_count) return NULL;
+    return j->data + j->frames[frame];
+}
+
+void journal_undo_frame(Journal* j, JournalUndoFn fn, void* ctx) {
+    if (j->frame_count == 0) return;
+
+    size_t pos = j->frames[j->frame_count - 1] + align8(j->header_size);
+    while (pos < j->size) {
+        JournalRecord rec;
+        memcpy(&rec, j->data + pos, sizeof(JournalRecord));
+        pos += sizeof(JournalRecord);
+
+        fn(ctx, rec.kind, rec.index, rec.offset, j->data + pos, rec.size);
+        pos += align8(rec.size);
+    }
+
+    j->size = j->frames[j->frame_count - 1];
+    j->frame_count--;
+}
@@ -0,0 +1,56 @@
+/*
+ * journal.h - Diário de desfazer (undo) em quadros
+ *
+ * Guarda o histórico da simulação como uma sequência de quadros, um por
+ * tick. Cada quadro começa com um cabeçalho de tamanho fixo (definido pelo
+ * usuário do diário) seguido de registros de alteração: para cada faixa de
+ * bytes modificada de um objeto (tipo, índice, deslocamento, tamanho), o
+ * valor antigo. Desfazer um quadro é copiar os valores antigos de volta.
+ * A memória é proporcional ao número de alterações, não ao tamanho do
+ * estado.
+ */
+
+#ifndef JOURNAL_H
+#define JOURNAL_H
+
+#include <stddef.h>
+
+typedef struct {
+    unsigned char* data;    /* Quadros (cabeçalho + registros) em sequência */
+    size_t size;            /* Bytes em uso */
+    size_t capacity;        /* Bytes alocados */
+    size_t* frames;         /* Deslocamento do início de cada quadro */
+    int frame_count;        /* Número de quadros */
+    int frame_capacity;     /* Capacidade alocada de frames */
+    size_t header_size;     /* Tamanho do cabeçalho de cada quadro */
+} Journal;
+
+/* Função chamada para cada registro ao desfazer um quadro:
+ * deve copiar 'old' (size bytes) para o deslocamento 'offset' do objeto
+ * identificado por (kind, index). */
+typedef void (*JournalUndoFn)(void* ctx, int kind, int index,
+                              int offset, const void* old, int size);
+
+/* Inicializa um diário vazio com cabeçalhos de header_size bytes */
+void journal_init(Journal* j, size_t header_size);
+
+/* Libera a memória do diário */
+void journal_free(Journal* j);
+
+/* Remove todos os quadros mantendo a memória alocada */
+void journal_clear(Journal* j);
+
+/* Abre um novo quadro com o cabeçalho dado */
+void journal_begin_frame(Journal* j, const void* header);
+
+/* Acrescenta ao quadro aberto o valor antigo de uma faixa de bytes */
+void journal_record(Journal* j, int kind, int index, int offset,
+                    const void* old, int size);
+
+/* Cabeçalho do quadro 'frame' (0 = mais antigo) */
+const void* journal_frame_header(const Journal* j, int frame);
+
+/* Desfaz o último quadro (aplicando seus registros) e o descarta */
+void journal_undo_frame(Journal* j, JournalUndoFn fn, void* ctx);
+
+#endif /* JOURNAL_H */
@@ -0,0 +1,284 @@
+/*
+ * screen_buffer.c - Tela de terminal com buffer duplo
+ * ---------------------------------------------------
+ * A comparação percorre as linhas guardando onde o cursor do terminal está
+ * e com que cores, para não repetir posicionamentos nem trocas de cor:
+ * células vizinhas são escritas em sequência, saltos curtos reescrevem as
+ * células iguais do meio (mais barato que mover o cursor) e o fim de linha
+ * que ficou em branco é apagado com uma só sequência.
+ *
+ * NOTA: Todas as funções auxiliares são marcadas como 'static'
+ * para evitar conflitos com outros módulos.
+ */
+
+#define _POSIX_C_SOURCE 200809L  /* write e ssize_t */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include "screen_buffer.h"
+
+#define SCREEN_GAP_FILL  3      /* Saltos até este tamanho reescrevem as células */
+
+/* ============================================================================
+ * FUNÇÕES AUXILIARES (STATIC - locais ao arquivo)
+ * ============================================================================ */
+
+static void out_append(ScreenBuffer* s, const char* data, size_t size) {
+    if (s->out_len + size > s->out_capacity) {
+        size_t capacity = (s->out_capacity > 0) ? s->out_capacity : 4096;
+        while (capacity < s->out_len + size) capacity *= 2;
+        char* out = realloc(s->out, capacity);
+        if (!out) {
+            s->error = 1;
+            return;
+        }
+        s->out = out;
+        s->out_capacity = capacity;
+    }
+    memcpy(s->out + s->out_len, data, size);
+    s->out_len += size;
+}
+
+static void out_vprintf(ScreenBuffer* s, const char* format, va_list args) {
+    char buffer[256];
+    int n = vsnprintf(buffer, sizeof(buffer), format, args);
+    if (n > 0) out_append(s, buffer, ((size_t)n < sizeof(buffer)) ? (size_t)n : sizeof(buffer) - 1);
+}
+
+static void out_printf(ScreenBuffer* s, const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    out_vprintf(s, format, args);
+    va_end(args);
+}
+
+static void cell_blank(ScreenCell* cell) {
+    memset(cell, 0, sizeof(ScreenCell));
+    cell->glyph[0] = ' ';
+}
+
+static int cell_equal(const ScreenCell* a, const ScreenCell* b) {
+    return a->attr == b->attr && memcmp(a->glyph, b->glyph, sizeof(a->glyph)) == 0;
+}
+
+static int cell_is_blank(const ScreenCell* cell) {
+    return cell->attr == 0 && cell->glyph[0] == ' ' && cell->glyph[1] == '\0';
+}
+
+/* Aplica os parâmetros de uma sequência SGR ("1;31") aos atributos */
+static unsigned short apply_sgr(unsigned short attr, const char* params, size_t size) {
+    size_t i = 0;
+    do {
+        int value = 0;
+        while (i < size && params[i] >= '0' && params[i] <= '9') {
+            value = value * 10 + (params[i++] - '0');
+        }
+        if (value == 0) attr = 0;
+        else if (value == 1) attr = (attr & ~SCREEN_DIM) | SCREEN_BOLD;
+        else if (value == 2) attr = (attr & ~SCREEN_BOLD) | SCREEN_DIM;
+        else if (value == 22) attr &= ~(SCREEN_BOLD | SCREEN_DIM);
+        else if (value >= 30 && value <= 37) attr = (attr & ~0x0F) | (value - 30 + 1);
+        else if (value == 39) attr &= ~0x0F;
+        else if (value >= 40 && value <= 47) attr = (attr & ~0xF0) | ((value - 40 + 1) << 4);
+        else if (value == 49) attr &= ~0xF0;
+    } while (i++ < size);   /* Pula o ';' */
+    return attr;
+}
+
+/* Deixa o terminal com os atributos attr (*current = -1: desconhecidos) */
+static void set_attr(ScreenBuffer* s, int* current, unsigned short attr) {
+    if (*current == attr) return;
+    char seq[32];
+    int n = sprintf(seq, "\033[0");
+    if (attr & SCREEN_BOLD) n += sprintf(seq + n, ";1");
+    if (attr & SCREEN_DIM) n += sprintf(seq + n, ";2");
+    if (attr & 0x0F) n += sprintf(seq + n, ";%d", 30 + (attr & 0x0F) - 1);
+    if (attr & 0xF0) n += sprintf(seq + n, ";%d", 40 + ((attr >> 4) & 0x0F) - 1);
+    seq[n++] = 'm';
+    out_append(s, seq, n);
+    *current = attr;
+}
+
+static void put_cell(ScreenBuffer* s, int* current, const ScreenCell* cell) {
+    set_attr(s, current, cell->attr);
+    size_t size = 1;
+    while (size < sizeof(cell->glyph) && cell->glyph[size] != '\0') size++;
+    out_append(s, cell->glyph, size);
+}
+
+/* ============================================================================
+ * FUNÇÕES PÚBLICAS
+ * ============================================================================ */
+
+void screen_init(ScreenBuffer* s) {
+    memset(s, 0, sizeof(ScreenBuffer));
+}
+
+int screen_resize(ScreenBuffer* s, int rows, int cols) {
+    size_t count = (size_t)rows * cols;
+    ScreenCell* back = realloc(s->back, count * sizeof(ScreenCell));
+    if (back) s->back = back;
+    ScreenCell* front = realloc(s->front, count * sizeof(ScreenCell));
+    if (front) s->front = front;
+    if (!back || !front) {
+        s->rows = s->cols = 0;
+        return 0;
+    }
+
+    s->rows = rows;
+    s->cols = cols;
+    for (size_t i = 0; i < count; i++) {
+        cell_blank(&s->back[i]);
+        cell_blank(&s->front[i]);
+    }
+    return 1;
+}
+
+void screen_begin(ScreenBuffer* s) {
+    size_t count = (size_t)s->rows * s->cols;
+    for (size_t i = 0; i < count; i++) cell_blank(&s->back[i]);
+}
+
+int screen_puts(ScreenBuffer* s, int row, int col, const char* text) {
+    const unsigned char* p = (const unsigned char*)text;
+    unsigned short attr = 0;
+    int c = col;
+
+    while (*p) {
+        if (*p == '\033' && p[1] == '[') {
+            /* Sequência CSI: parâmetros até o byte final */
+            const unsigned char* params = p + 2;
+            const unsigned char* end = params;
+            while (*end && (*end < 0x40 || *end > 0x7E)) end++;
+            if (!*end) break;
+            if (*end == 'm') attr = apply_sgr(attr, (const char*)params, end - params);
+            p = end + 1;
+            continue;
+        }
+        if (*p == '\n') {
+            row++;
+            c = col;
+            p++;
+            continue;
+        }
+        if (*p < 0x20) {
+            p++;
+            continue;
+        }
+
+        size_t size = 1;
+        if ((*p & 0xE0) == 0xC0) size = 2;
+        else if ((*p & 0xF0) == 0xE0) size = 3;
+        else if ((*p & 0xF8) == 0xF0) size = 4;
+        for (size_t k = 1; k < size; k++) {
+            if ((p[k] & 0xC0) != 0x80) size = k;   /* UTF-8 inválido */
+        }
+
+        if (row >= 0 && row < s->rows && c >= 0 && c < s->cols) {
+            ScreenCell* cell = &s->back[(size_t)row * s->cols + c];
+            memset(cell->glyph, 0, sizeof(cell->glyph));
+            memcpy(cell->glyph, p, size);
+            cell->attr = attr;
+        }
+        c++;
+        p += size;
+    }
+    return c;
+}
+
+int screen_printf(ScreenBuffer* s, int row, int col, const char* format, ...) {
+    char buffer[512];
+    va_list args;
+    va_start(args, format);
+    int n = vsnprintf(buffer, sizeof(buffer), format, args);
+    va_end(args);
+    if (n < 0) return col;
+
+    if ((size_t)n < sizeof(buffer)) return screen_puts(s, row, col, buffer);
+
+    /* Texto longo: formatar de novo em memória alocada */
+    char* text = malloc((size_t)n + 1);
+    if (!text) return col;
+    va_start(args, format);
+    vsnprintf(text, (size_t)n + 1, format, args);
+    va_end(args);
+    int end = screen_puts(s, row, col, text);
+    free(text);
+    return end;
+}
+
+void screen_emit(ScreenBuffer* s, const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    out_vprintf(s, format, args);
+    va_end(args);
+}
+
+void screen_present(ScreenBuffer* s) {
+    int cur_row = -1;           /* Posição do cursor (-1 = desconhecida) */
+    int cur_col = -1;
+    int cur_attr = -1;          /* Cores do terminal (-1 = desconhecidas) */
+
+    for (int r = 0; r < s->rows; r++) {
+        ScreenCell* back = s->back + (size_t)r * s->cols;
+        ScreenCell* front = s->front + (size_t)r * s->cols;
+
+        /* Depois da última célula não-branca, a linha pode ser apagada */
+        int last = s->cols;
+        while (last > 0 && cell_is_blank(&back[last - 1])) last--;
+
+        for (int c = 0; c < s->cols; c++) {
+            if (cell_equal(&back[c], &front[c])) continue;
+
+            if (cur_row == r && cur_col < c && c - cur_col <= SCREEN_GAP_FILL) {
+                for (int k = cur_col; k < c; k++) put_cell(s, &cur_attr, &back[k]);
+            } else if (cur_row == r && cur_col < c) {
+                out_printf(s, "\033[%dC", c - cur_col);
+            } else if (cur_row != r || cur_col != c) {
+                out_printf(s, "\033[%d;%dH", r + 1, c + 1);
+            }
+            cur_row = r;
+            cur_col = c;
+
+            if (c >= last) {
+                set_attr(s, &cur_attr, 0);
+                out_append(s, "\033[K", 3);
+                for (int k = c; k < s->cols; k++) cell_blank(&front[k]);
+                break;
+            }
+
+            put_cell(s, &cur_attr, &back[c]);
+            front[c] = back[c];
+            cur_col = c + 1;
+            if (cur_col >= s->cols) cur_row = -1;   /* Cursor na margem: posição incerta */
+        }
+    }
+
+    if (cur_attr > 0) set_attr(s, &cur_attr, 0);
+}
+
+int screen_flush(ScreenBuffer* s, int fd) {
+    size_t done = 0;
+    while (done < s->out_len) {
+        ssize_t n = write(fd, s->out + done, s->out_len - done);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            s->error = 1;
+            break;
+        }
+        done += (size_t)n;
+    }
+    s->out_len = 0;
+    return !s->error;
+}
+
+void screen_free(ScreenBuffer* s) {
+    free(s->back);
+    free(s->front);
+    free(s->out);
+    memset(s, 0, sizeof(ScreenBuffer));
+}
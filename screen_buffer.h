@@ -0,0 +1,74 @@
+/*
+ * screen_buffer.h - Tela de terminal com buffer duplo
+ *
+ * Guarda duas grades de células (caractere + cor): a que o terminal está
+ * mostrando e a do próximo quadro. O quadro é montado inteiro em memória
+ * com screen_puts / screen_printf, que entendem as sequências de cor SGR
+ * ("\033[...m") já usadas nos textos do modo debug. screen_present compara
+ * as duas grades e gera só o necessário para as células que mudaram
+ * (posição do cursor, troca de cor e o caractere), e screen_flush entrega
+ * tudo ao terminal em uma única chamada write.
+ *
+ * Cada caractere UTF-8 ocupa uma coluna, o que vale para todos os símbolos
+ * dos quadros (blocos, bordas, setas e letras acentuadas).
+ */
+
+#ifndef SCREEN_BUFFER_H
+#define SCREEN_BUFFER_H
+
+#include <stddef.h>
+
+/* Atributos de uma célula: cor do texto (bits 0-3, 0 = padrão, senão
+ * 1 + cor ANSI 0-7), cor de fundo (bits 4-7, idem) e estilo */
+#define SCREEN_BOLD  0x100
+#define SCREEN_DIM   0x200
+
+typedef struct {
+    char glyph[4];              /* Caractere UTF-8 (bytes não usados = 0) */
+    unsigned short attr;        /* Cores e estilo */
+} ScreenCell;
+
+typedef struct {
+    int rows, cols;             /* Tamanho da área controlada (a partir do topo) */
+    ScreenCell* back;           /* Quadro em montagem */
+    ScreenCell* front;          /* O que o terminal mostra */
+    char* out;                  /* Bytes da próxima escrita */
+    size_t out_len;
+    size_t out_capacity;
+    int error;                  /* Falta de memória ou escrita falhou */
+} ScreenBuffer;
+
+/* Prepara uma tela vazia (sem células) */
+void screen_init(ScreenBuffer* s);
+
+/* Muda o tamanho da área, considerando o terminal já limpo nela
+ * (retorna 0 se faltar memória) */
+int screen_resize(ScreenBuffer* s, int rows, int cols);
+
+/* Começa um quadro novo: todas as células em branco */
+void screen_begin(ScreenBuffer* s);
+
+/* Escreve texto a partir de (row, col), contados de 0. '\n' volta para a
+ * coluna col na linha seguinte; o que passa da área é descartado. Cada
+ * chamada começa com as cores padrão. Retorna a coluna após o texto. */
+int screen_puts(ScreenBuffer* s, int row, int col, const char* text);
+
+/* Como screen_puts, com texto formatado (como printf) */
+int screen_printf(ScreenBuffer* s, int row, int col, const char* format, ...);
+
+/* Acrescenta uma sequência de controle à próxima escrita, como está
+ * (região de rolagem, guardar o cursor...) */
+void screen_emit(ScreenBuffer* s, const char* format, ...);
+
+/* Compara o quadro montado com o que está no terminal e acrescenta à
+ * próxima escrita só as células que mudaram (termina nas cores padrão) */
+void screen_present(ScreenBuffer* s);
+
+/* Entrega a escrita acumulada ao descritor fd em uma chamada write
+ * (retorna 0 se falhou) */
+int screen_flush(ScreenBuffer* s, int fd);
+
+/* Libera a memória da tela */
+void screen_free(ScreenBuffer* s);
+
+#endif /* SCREEN_BUFFER_H */
@@ -7,29 +7,53 @@
  * preemptivo de tempo compartilhado, conforme especificado no projeto.
  *
  * FUNCIONALIDADES IMPLEMENTADAS:
- * - Algoritmos de escalonamento: FIFO, RR (Round-Robin), SRTF, PRIORITY
+ * - Algoritmos de escalonamento: FIFO, RR (Round-Robin), SRTF, PRIORITY, EDF,
+ *   LOTTERY e STRIDE (compartilhamento proporcional por bilhetes)
+ * - Prazos (deadlines) opcionais com contabilização de perdas de prazo
+ * - Tarefas periódicas com criação preguiçosa de jobs e reciclagem de TCBs
+ * - Custo de troca de contexto e penalidade de cache frio (opcionais)
  * - Modo de execução completa e passo-a-passo com depuração
- * - Sistema de histórico para avançar/retroceder a simulação (req. 1.5.2)
+ * - Histórico em diário de alterações para avançar/retroceder (req. 1.5.2),
+ *   com quadros-chave opcionalmente guardados em arquivo temporário
  * - Geração de gráfico de Gantt (BMP e ASCII)
  * - Estatísticas detalhadas de execução
  * - Estrutura preparada para eventos do Projeto B (mutex, I/O)
  *
  * FORMATO DO ARQUIVO DE CONFIGURAÇÃO:
  *   algoritmo_escalonamento;quantum
- *   id;cor;ingresso;duracao;prioridade;lista_eventos
+ *   id;cor;ingresso;duracao;prioridade;lista_eventos[;deadline][;bilhetes]
+ *   P;id;cor;periodo;fase;wcet;prioridade[;deadline][;bilhetes]   (periódica)
  *
  * Autor: [Seu Nome]
  * Disciplina: Sistemas Operacionais
  */
 
+#define _POSIX_C_SOURCE 200809L  // fileno, mmap e sysconf (histórico em disco)
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <ctype.h>
 #include <stdbool.h>
 #include <limits.h>
+#include <sys/mman.h>
+#include <time.h>
+#include <termios.h>
+#include <sys/ioctl.h>
+#include <sys/select.h>
+#include <unistd.h>
 #include "gantt_bmp.h"
 #include "gantt_ascii.h"
+#include "gantt_svg.h"
+#include "gantt_index.h"
 #include "stats_viewer.h"
+#include "task_heap.h"
+#include "ticket_tree.h"
+#include "journal.h"
+#include "arena.h"
+#include "screen_buffer.h"
+#include "task_map.h"
+#include "text_writer.h"
 
 // =============================================================================
 // CONSTANTES E DEFINIÇÕES
@@ -37,8 +61,17 @@
 
 #define MAX_TASKS       100     // Número máximo de tarefas
 #define MAX_EVENTS      50      // Número máximo de eventos por tarefa
-#define MAX_HISTORY     10000   // Número máximo de snapshots no histórico
 #define MAX_LINE_LEN    512     // Tamanho máximo de linha do arquivo config
+#define MAX_AUTO_HORIZON 100000 // Limite do horizonte calculado automaticamente
+#define STRIDE1         (1 << 20) // Constante do STRIDE (passo = STRIDE1 / bilhetes)
+#define DEFAULT_SEED    12345   // Semente padrão do sorteio (LOTTERY)
+#define OVERHEAD_COLOR  "#808080" // Cor das entradas de overhead no Gantt
+#define KEYFRAME_INTERVAL 256   // Intervalo inicial entre quadros-chave (ticks)
+#define KEYFRAME_BUDGET (64 * 1024 * 1024) // Memória máxima dos quadros-chave
+#define MIN_KEYFRAMES   16      // Quadros-chave mantidos antes de espaçar
+#define DISK_KEYFRAME_INTERVAL 32 // Intervalo entre quadros-chave em disco
+#define DEFAULT_BMP_WIDTH 16384 // Largura máxima padrão do BMP (0 = sem limite)
+#define DEFAULT_PLAY_RATE 10    // Ticks por segundo da reprodução no modo debug
 
 // =============================================================================
 // ENUMERAÇÕES
@@ -53,9 +86,25 @@ typedef enum {
     STATE_READY,        // Tarefa pronta para executar (na fila de prontos)
     STATE_RUNNING,      // Tarefa em execução na CPU
     STATE_BLOCKED,      // Tarefa bloqueada (aguardando I/O ou mutex)
-    STATE_TERMINATED    // Tarefa concluída
+    STATE_TERMINATED,   // Tarefa concluída
+    STATE_FREE          // Slot de job periódico livre (TCB reciclado)
 } TaskState;
 
+/**
+ * Políticas de escalonamento suportadas.
+ * O nome do algoritmo é resolvido uma única vez na criação do simulador,
+ * evitando comparações de strings a cada tick.
+ */
+typedef enum {
+    POLICY_FIFO,
+    POLICY_RR,
+    POLICY_SRTF,
+    POLICY_PRIORITY,
+    POLICY_EDF,         // Earliest Deadline First (prazo absoluto mais próximo)
+    POLICY_LOTTERY,     // Sorteio proporcional aos bilhetes
+    POLICY_STRIDE       // Passo determinístico proporcional aos bilhetes
+} SchedPolicy;
+
 /**
  * Tipos de eventos que podem ocorrer durante a execução de uma tarefa.
  * Preparado para o Projeto B.
@@ -96,6 +145,12 @@ typedef struct {
     int remaining_time;         // Tempo restante de CPU
     int priority;               // Prioridade (menor = mais prioritário)
 
+    // Prazo (tempo real)
+    int deadline;               // Prazo relativo à chegada (0 = sem prazo)
+    int abs_deadline;           // Prazo absoluto (chegada + deadline, -1 se sem prazo)
+    int lateness;               // Atraso no término (completion - abs_deadline)
+    bool deadline_missed;       // Terminou depois do prazo
+
     // Estado atual
     TaskState state;            // Estado atual da tarefa
 
@@ -116,19 +171,82 @@ typedef struct {
 
     // I/O (Projeto B)
     int io_remaining;           // Tempo restante de I/O (0 = não está em I/O)
+
+    // Jobs de tarefas periódicas
+    int periodic_idx;           // Tarefa periódica de origem (-1 = tarefa comum)
+    int job_seq;                // Número do job dentro da tarefa periódica
+
+    // Compartilhamento proporcional (LOTTERY/STRIDE)
+    int tickets;                // Bilhetes (coluna própria ou derivados da prioridade)
+    long long pass;             // Valor de passagem (STRIDE)
+    double share_mark;          // Relógio de fatia quando a tarefa ficou pronta
+    double entitled;            // Ticks de CPU a que a tarefa teve direito
 } TCB;
 
+/**
+ * Definição de uma tarefa periódica.
+ * Cada job é instanciado apenas quando chega seu instante de liberação,
+ * ocupando um TCB reciclado; ao terminar, o TCB volta para a lista livre.
+ * Assim a memória é proporcional aos jobs vivos, não ao horizonte simulado.
+ */
+typedef struct {
+    // Definição (arquivo de configuração)
+    int id;                     // ID da tarefa (linha do Gantt)
+    char color[8];              // Cor em hexadecimal (#RRGGBB)
+    int period;                 // Período entre liberações
+    int phase;                  // Instante da primeira liberação
+    int wcet;                   // Tempo de CPU de cada job
+    int priority;               // Prioridade de cada job
+    int deadline;               // Prazo relativo de cada job (padrão = período)
+    int tickets;                // Bilhetes de cada job (LOTTERY/STRIDE)
+
+    // Estado da simulação
+    int next_release;           // Próximo instante de liberação
+    int jobs_released;          // Jobs liberados até agora
+    int jobs_completed;         // Jobs concluídos
+    int deadline_misses;        // Jobs que terminaram após o prazo
+    long long total_response;   // Soma dos tempos de resposta
+    long long total_turnaround; // Soma dos turnarounds
+    int max_response;           // Maior tempo de resposta
+    int max_lateness;           // Maior atraso (término - prazo)
+    double total_entitled;      // Soma da fatia de direito dos jobs concluídos
+} PeriodicTask;
+
 /**
  * Configuração da simulação carregada do arquivo.
  */
 typedef struct {
-    char algorithm[20];         // Nome do algoritmo (FIFO, RR, SRTF, PRIORITY)
+    char algorithm[20];         // Nome do algoritmo (FIFO, RR, SRTF, PRIORITY, EDF, LOTTERY, STRIDE)
     int quantum;                // Quantum para RR
     int alpha;                  // Parâmetro alpha para envelhecimento (Projeto B)
     TCB* tasks;                 // Array de tarefas
     int task_count;             // Número de tarefas
+    PeriodicTask* periodic;     // Definições de tarefas periódicas
+    int periodic_count;         // Número de tarefas periódicas
+    int horizon;                // Última liberação de jobs (0 = automático)
+    unsigned int seed;          // Semente do sorteio (LOTTERY)
+    int switch_cost;            // Ticks gastos em cada troca de contexto
+    int cache_penalty;          // Ticks extras ao retomar uma tarefa (cache frio)
+    bool history;               // Manter histórico para retroceder (modo debug)
+    bool disk_history;          // Guardar quadros-chave em arquivo temporário
 } SimConfig;
 
+/**
+ * Registro do Gantt, único para toda a simulação.
+ * Só muda no fim (nova entrada ou extensão da última), então um ponto do
+ * histórico é identificado pelo número de entradas e pelo fim da última,
+ * e voltar a ele é apenas truncar o registro. O índice por linha acompanha
+ * as entradas e responde às janelas do modo debug sem varrer tudo. As
+ * entradas não guardam cor: ela é a da linha, na paleta montada no reset.
+ */
+typedef struct {
+    GanttEntry* entries;        // Entradas em ordem cronológica
+    int count;                  // Número de entradas
+    int capacity;               // Capacidade alocada
+    GanttIndex index;           // Entradas de cada linha (gantt_index)
+    GanttPalette palette;       // Cor de cada linha (gantt_palette)
+} GanttLog;
+
 /**
  * Relógio do sistema simulado.
  */
@@ -138,38 +256,135 @@ typedef struct {
 } SystemClock;
 
 /**
- * Snapshot do estado do sistema em um determinado tick.
- * Usado para implementar o retrocesso da simulação (req. 1.5.2).
+ * Snapshot do estado escalar do sistema no início de um tick.
+ * É o cabeçalho de cada quadro do diário de histórico (req. 1.5.2): as
+ * alterações de TCBs e tarefas periódicas ficam nos registros do quadro.
+ * O Gantt e o registro de perdas só crescem (ou estendem a última
+ * entrada), então bastam os tamanhos e o fim da última entrada do Gantt.
  */
 typedef struct {
     int tick;                   // Tick deste snapshot
-    TCB* tasks;                 // Cópia do array de tarefas
-    int task_count;             // Número de tarefas
-    int current_task_id;        // ID da tarefa em execução (-1 se nenhuma)
-    GanttEntry* gantt_entries;  // Entradas do Gantt até este ponto
+    int task_count;             // Número de slots de tarefas
+    int current_task_idx;       // Slot da tarefa em execução (-1 se nenhuma)
     int gantt_count;            // Número de entradas do Gantt
+    int gantt_last_end;         // Fim da última entrada do Gantt
+    int miss_count;             // Perdas de prazo de tarefas comuns
+    unsigned long long rng_state; // Estado do gerador pseudoaleatório
+    double share_clock;         // Relógio de fatia proporcional
+    int overhead_remaining;     // Overhead restante da troca em andamento
+    int switch_count;           // Trocas de contexto até este ponto
+    int overhead_ticks;         // Ticks de overhead até este ponto
 } Snapshot;
 
+/**
+ * Tipos de objeto registrados no diário de histórico.
+ */
+typedef enum {
+    HIST_TASK,          // TCB (índice = slot)
+    HIST_PERIODIC,      // Tarefa periódica (índice = posição em periodic)
+    HIST_JOB_SUMMARY    // Resumo dos jobs periódicos (índice 0)
+} HistoryKind;
+
+/**
+ * Objeto alterado no tick atual e deslocamento da sua imagem inicial.
+ */
+typedef struct {
+    int kind;                   // HistoryKind
+    int index;                  // Índice do objeto
+    size_t image;               // Deslocamento da imagem em touch_images
+} HistoryTouch;
+
+/**
+ * Quadro-chave: cópia completa do estado em um tick múltiplo do intervalo.
+ * Voltar para antes do diário restaura o quadro-chave anterior mais próximo
+ * e reexecuta a simulação até o tick desejado.
+ */
+typedef struct {
+    Snapshot state;             // Estado escalar do tick
+    TCB* tasks;                 // Cópia dos slots [0, state.task_count)
+    PeriodicTask* periodic;     // Cópia das tarefas periódicas
+    TaskSummary* job_summary;   // Cópia do resumo dos jobs periódicos
+    size_t bytes;               // Memória ocupada pelas cópias
+    long offset;                // Posição no arquivo de histórico (-1 = em memória)
+} Keyframe;
+
 /**
  * Estrutura principal do simulador.
  */
 typedef struct {
     // Estado atual
     SystemClock clock;          // Relógio do sistema
-    TCB* tasks;                 // Array de tarefas
-    int task_count;             // Número de tarefas
+    TCB* tasks;                 // Tarefas comuns seguidas dos slots de jobs
+    int task_count;             // Número de slots em uso (comuns + jobs)
+    int task_capacity;          // Capacidade alocada de tasks
+    int static_count;           // Número de tarefas comuns (slots iniciais)
+    int row_count;              // Linhas do Gantt (comuns + periódicas)
+    TaskMap id_rows;            // Id da configuração -> linha do Gantt
     TCB* current_task;          // Ponteiro para tarefa em execução
     char algorithm[20];         // Algoritmo de escalonamento
+    SchedPolicy policy;         // Política resolvida a partir de algorithm
+
+    // Filas do escalonador
+    int* arrival_order;         // Índices das tarefas ordenados por chegada
+    int next_arrival;           // Próxima posição de arrival_order a chegar
+    int completed_count;        // Número de tarefas concluídas
+    TaskSummary summary;        // Métricas das concluídas, acumuladas no término
+    TaskSummary job_summary;    // Idem para os jobs periódicos (no histórico)
+    TaskHeap ready_heap;        // Prontas por prazo (EDF) ou passagem (STRIDE)
+
+    // Compartilhamento proporcional (LOTTERY/STRIDE)
+    TicketTree tickets;         // Bilhetes das tarefas prontas
+    unsigned long long rng_state; // Estado do gerador pseudoaleatório
+    double share_clock;         // Soma de 1/bilhetes_prontos por tick executado
+
+    // Custo de troca de contexto
+    int switch_cost;            // Ticks gastos em cada troca de contexto
+    int cache_penalty;          // Ticks extras ao retomar uma tarefa (cache frio)
+    int overhead_remaining;     // Ticks de overhead ainda devidos pela troca atual
+    int switch_count;           // Trocas de contexto realizadas
+    int overhead_ticks;         // Ticks de CPU perdidos com overhead
+
+    // Tarefas periódicas
+    PeriodicTask* periodic;     // Definições e estado das tarefas periódicas
+    int periodic_count;         // Número de tarefas periódicas
+    int horizon;                // Nenhum job é liberado a partir deste tick
+    TaskHeap release_heap;      // Tarefas periódicas por próxima liberação
+    TaskHeap free_slots;        // Slots de job livres (menor índice primeiro)
+    int live_jobs;              // Jobs liberados e ainda não concluídos
+
+    // Perdas de prazo (cada TCB guarda a sua; jobs periódicos são contados
+    // por tarefa periódica, então a memória não cresce com o horizonte)
+    int miss_count;             // Tarefas comuns que perderam o prazo
 
     // Gantt Chart
-    GanttEntry* gantt_entries;  // Entradas para o gráfico de Gantt
-    int gantt_count;            // Número de entradas
-    int gantt_capacity;         // Capacidade alocada
-
-    // Sistema de histórico (para retrocesso)
-    Snapshot* history;          // Array de snapshots
-    int history_count;          // Número de snapshots salvos
-    int history_capacity;       // Capacidade alocada
+    GanttLog gantt;             // Entradas para o gráfico de Gantt
+
+    // Sistema de histórico (diário de desfazer, um quadro por tick)
+    bool history_enabled;       // false: nenhum quadro é gravado
+    Journal history;            // Quadros: Snapshot + valores antigos alterados
+    HistoryTouch* touched;      // Objetos alterados no tick atual
+    int touched_count;          // Número de objetos alterados
+    int touched_capacity;       // Capacidade alocada
+    unsigned char* touch_images; // Imagens dos objetos no início do tick
+    size_t touch_images_size;   // Bytes em uso
+    size_t touch_images_capacity; // Bytes alocados
+    int* task_stamp;            // Quadro em que cada slot foi registrado
+    int* periodic_stamp;        // Quadro em que cada periódica foi registrada
+    int job_summary_stamp;      // Quadro em que job_summary foi registrado
+    int stamp_capacity;         // Capacidade de task_stamp
+    int frame_serial;           // Número do quadro atual (nunca se repete)
+    int frame_task_count;       // task_count no início do quadro atual
+    Keyframe* keyframes;        // Quadros-chave em ordem crescente de tick
+    int keyframe_count;         // Número de quadros-chave
+    int keyframe_capacity;      // Capacidade alocada
+    int keyframe_interval;      // Ticks entre quadros-chave (dobra ao espaçar)
+    size_t keyframe_bytes;      // Memória total dos quadros-chave
+    FILE* history_file;         // Arquivo de quadros-chave (NULL = memória)
+    long history_file_end;      // Fim dos dados válidos no arquivo
+
+    // Memória
+    Arena arena;                // Alocações que vivem tanto quanto o simulador
+    Arena scratch;              // Temporários (zerada a cada quadro do debug)
 
     // Controle
     bool verbose;               // Modo verboso (imprime cada tick)
@@ -191,15 +406,23 @@ TCB* copy_tasks(TCB* src, int count) {
 }
 
 /**
- * Cria uma cópia profunda de um array de GanttEntry.
+ * Fim da última entrada do Gantt (0 se vazio).
  */
-GanttEntry* copy_gantt(GanttEntry* src, int count) {
-    if (count == 0) return NULL;
-    GanttEntry* dst = malloc(count * sizeof(GanttEntry));
-    if (dst) {
-        memcpy(dst, src, count * sizeof(GanttEntry));
+int gantt_log_last_end(const GanttLog* log) {
+    return (log->count > 0) ? log->entries[log->count - 1].end_time : 0;
+}
+
+/**
+ * Volta o Gantt a um ponto anterior: descarta as entradas novas e desfaz
+ * a extensão da última.
+ */
+void gantt_log_truncate(GanttLog* log, int count, int last_end) {
+    if (count > log->count) return;
+    log->count = count;
+    gantt_index_truncate(&log->index, count);
+    if (count > 0) {
+        log->entries[count - 1].end_time = last_end;
     }
-    return dst;
 }
 
 // =============================================================================
@@ -249,12 +472,101 @@ void parse_events(TCB* task, const char* event_str) {
     }
 }
 
+/**
+ * Extrai o próximo campo separado por ';' a partir de *cursor.
+ * Diferente de strtok, preserva campos vazios ("a;;b" tem três campos),
+ * o que permite omitir a lista de eventos e ainda informar o prazo.
+ *
+ * @return Início do campo, ou NULL quando não há mais campos
+ */
+static char* next_field(char** cursor) {
+    char* start = *cursor;
+    if (!start) return NULL;
+
+    char* sep = strchr(start, ';');
+    if (sep) {
+        *sep = '\0';
+        *cursor = sep + 1;
+    } else {
+        *cursor = NULL;
+    }
+    return start;
+}
+
+/**
+ * Bilhetes derivados da prioridade quando a coluna de bilhetes é omitida:
+ * inversamente proporcionais (prioridade 1 = 100 bilhetes, 2 = 50, ...).
+ */
+static int tickets_from_priority(int priority) {
+    if (priority <= 0) return 100;
+    int tickets = 100 / priority;
+    return (tickets > 0) ? tickets : 1;
+}
+
+/**
+ * Lê um campo numérico opcional. Campo ausente ou vazio mantém *value.
+ *
+ * @return false se o campo tem texto que não é um número inteiro
+ */
+static bool parse_optional_int(const char* field, int* value) {
+    if (!field) return true;
+    while (isspace((unsigned char)*field)) field++;
+    if (*field == '\0') return true;
+
+    char* end;
+    long parsed = strtol(field, &end, 10);
+    while (isspace((unsigned char)*end)) end++;
+    if (end == field || *end != '\0' || parsed < INT_MIN || parsed > INT_MAX) return false;
+    *value = (int)parsed;
+    return true;
+}
+
+/**
+ * Faz o parse de uma linha de tarefa periódica (sem o prefixo "P;").
+ * Formato: id;cor;periodo;fase;wcet;prioridade[;deadline][;bilhetes]
+ *
+ * @return true se a linha é válida
+ */
+static bool parse_periodic(PeriodicTask* pt, const char* line) {
+    memset(pt, 0, sizeof(PeriodicTask));
+
+    int consumed = 0;
+    int parsed = sscanf(line, "%d;%7[^;];%d;%d;%d;%d%n",
+                        &pt->id, pt->color, &pt->period, &pt->phase,
+                        &pt->wcet, &pt->priority, &consumed);
+    if (parsed < 6 || pt->period <= 0 || pt->wcet <= 0) return false;
+
+    // Campos opcionais após a prioridade (vazios mantêm o padrão)
+    char buffer[MAX_LINE_LEN];
+    strncpy(buffer, line + consumed, sizeof(buffer) - 1);
+    buffer[sizeof(buffer) - 1] = '\0';
+    char* rest = (buffer[0] == ';') ? buffer + 1 : NULL;
+
+    char* deadline_str = next_field(&rest);
+    char* tickets_str = next_field(&rest);
+    if (!parse_optional_int(deadline_str, &pt->deadline) ||
+        !parse_optional_int(tickets_str, &pt->tickets)) {
+        printf("Aviso: Tarefa periódica %d com campo não numérico; linha ignorada\n", pt->id);
+        return false;
+    }
+
+    // Prazo implícito: igual ao período
+    if (pt->deadline <= 0) pt->deadline = pt->period;
+    if (pt->tickets <= 0) pt->tickets = tickets_from_priority(pt->priority);
+    if (pt->phase < 0) pt->phase = 0;
+    return true;
+}
+
 /**
  * Carrega a configuração da simulação a partir de um arquivo texto.
  *
  * Formato do arquivo:
  *   Linha 1: algoritmo;quantum[;alpha]
- *   Linhas seguintes: id;cor;ingresso;duracao;prioridade;[eventos]
+ *   Linhas seguintes: id;cor;ingresso;duracao;prioridade;[eventos][;deadline][;bilhetes]
+ *                 ou: P;id;cor;periodo;fase;wcet;prioridade[;deadline][;bilhetes]
+ *
+ * O prazo (deadline) é relativo ao ingresso; ausente ou 0 significa que a
+ * tarefa não tem prazo. Para tarefas periódicas o prazo padrão é o período.
  *
  * @param filename Nome do arquivo de configuração
  * @return Ponteiro para SimConfig ou NULL em caso de erro
@@ -305,6 +617,16 @@ SimConfig* parse_config(const char* filename) {
     config->tasks = malloc(capacity * sizeof(TCB));
     config->task_count = 0;
 
+    int periodic_capacity = 0;
+    config->periodic = NULL;
+    config->periodic_count = 0;
+    config->horizon = 0;
+    config->seed = DEFAULT_SEED;
+    config->switch_cost = 0;
+    config->cache_penalty = 0;
+    config->history = true;
+    config->disk_history = false;
+
     // Ler tarefas
     while (fgets(line, sizeof(line), f)) {
         // Remover newline
@@ -313,6 +635,19 @@ SimConfig* parse_config(const char* filename) {
         // Pular linhas vazias ou comentários
         if (strlen(line) < 3 || line[0] == '#') continue;
 
+        // Tarefa periódica: P;id;cor;periodo;fase;wcet;prioridade[;deadline][;bilhetes]
+        if ((line[0] == 'P' || line[0] == 'p') && line[1] == ';') {
+            if (config->periodic_count >= periodic_capacity) {
+                periodic_capacity = periodic_capacity ? periodic_capacity * 2 : 4;
+                config->periodic = realloc(config->periodic,
+                                           periodic_capacity * sizeof(PeriodicTask));
+            }
+            if (parse_periodic(&config->periodic[config->periodic_count], line + 2)) {
+                config->periodic_count++;
+            }
+            continue;
+        }
+
         // Expandir array se necessário
         if (config->task_count >= capacity) {
             capacity *= 2;
@@ -324,34 +659,62 @@ SimConfig* parse_config(const char* filename) {
         // Inicializar tarefa
         memset(task, 0, sizeof(TCB));
         task->start_time = -1;
+        task->abs_deadline = -1;
+        task->periodic_idx = -1;
         task->state = STATE_NEW;
 
-        // Parse: id;cor;ingresso;duracao;prioridade;eventos
-        char events_str[256] = "";
-        int parsed = sscanf(line, "%d;%7[^;];%d;%d;%d;%255[^\n]",
+        // Parse: id;cor;ingresso;duracao;prioridade;eventos[;deadline][;bilhetes]
+        int consumed = 0;
+        int parsed = sscanf(line, "%d;%7[^;];%d;%d;%d%n",
                            &task->id,
                            task->color,
                            &task->arrival_time,
                            &task->burst_time,
                            &task->priority,
-                           events_str);
+                           &consumed);
 
         if (parsed >= 5) {
             task->remaining_time = task->burst_time;
             task->quantum_remaining = config->quantum;
 
+            // Campos opcionais após a prioridade
+            char* rest = line + consumed;
+            if (*rest == ';') rest++;
+            else rest = NULL;
+
+            char* events_str = next_field(&rest);
+            char* deadline_str = next_field(&rest);
+            char* tickets_str = next_field(&rest);
+
+            // Prazo relativo e bilhetes (opcionais; vazios mantêm o padrão)
+            if (!parse_optional_int(deadline_str, &task->deadline) ||
+                !parse_optional_int(tickets_str, &task->tickets)) {
+                printf("Aviso: Tarefa %d com campo não numérico; linha ignorada\n", task->id);
+                continue;
+            }
+
             // Parse eventos (para Projeto B)
-            if (strlen(events_str) > 0) {
+            if (events_str && strlen(events_str) > 0) {
                 parse_events(task, events_str);
             }
 
+            // Sem prazo: 0 (ou negativo)
+            if (task->deadline > 0) {
+                task->abs_deadline = task->arrival_time + task->deadline;
+            } else {
+                task->deadline = 0;
+            }
+
+            // Bilhetes ausentes: derivados da prioridade
+            if (task->tickets <= 0) task->tickets = tickets_from_priority(task->priority);
+
             config->task_count++;
         }
     }
 
     fclose(f);
 
-    if (config->task_count == 0) {
+    if (config->task_count == 0 && config->periodic_count == 0) {
         printf("Erro: Nenhuma tarefa encontrada no arquivo\n");
         free(config->tasks);
         free(config);
@@ -360,28 +723,262 @@ SimConfig* parse_config(const char* filename) {
 
     printf("Configuração carregada: %s, quantum=%d, %d tarefas\n",
            config->algorithm, config->quantum, config->task_count);
+    if (config->periodic_count > 0) {
+        printf("                        %d tarefas periódicas\n", config->periodic_count);
+    }
 
     return config;
 }
 
+/**
+ * Libera a configuração carregada por parse_config.
+ */
+void free_config(SimConfig* config) {
+    if (!config) return;
+    free(config->tasks);
+    free(config->periodic);
+    free(config);
+}
+
 // =============================================================================
 // GERENCIAMENTO DO SIMULADOR
 // =============================================================================
 
 /**
- * Cria e inicializa uma nova instância do simulador.
+ * Converte o nome do algoritmo na política correspondente.
+ * Algoritmo desconhecido resulta em FIFO (com aviso).
  */
-Simulator* create_simulator(SimConfig* config) {
-    Simulator* sim = malloc(sizeof(Simulator));
-    if (!sim) return NULL;
+static SchedPolicy parse_policy(const char* name) {
+    if (strcmp(name, "FIFO") == 0) return POLICY_FIFO;
+    if (strcmp(name, "RR") == 0) return POLICY_RR;
+    if (strcmp(name, "SRTF") == 0) return POLICY_SRTF;
+    if (strcmp(name, "PRIORITY") == 0) return POLICY_PRIORITY;
+    if (strcmp(name, "EDF") == 0) return POLICY_EDF;
+    if (strcmp(name, "LOTTERY") == 0) return POLICY_LOTTERY;
+    if (strcmp(name, "STRIDE") == 0) return POLICY_STRIDE;
+
+    printf("Aviso: Algoritmo '%s' desconhecido, usando FIFO\n", name);
+    return POLICY_FIFO;
+}
+
+/**
+ * Par (chegada, índice) usado para ordenar as tarefas por chegada.
+ */
+typedef struct {
+    int arrival;
+    int index;
+} ArrivalKey;
+
+static int compare_arrival(const void* a, const void* b) {
+    const ArrivalKey* ka = a;
+    const ArrivalKey* kb = b;
+    if (ka->arrival != kb->arrival) return (ka->arrival < kb->arrival) ? -1 : 1;
+    return ka->index - kb->index;
+}
+
+/**
+ * Chave de ordenação EDF: prazo absoluto (sem prazo = infinito).
+ */
+static long long edf_key(const TCB* task) {
+    return (task->abs_deadline >= 0) ? task->abs_deadline : INT_MAX;
+}
+
+/**
+ * Verifica se a política reparte a CPU por bilhetes (LOTTERY/STRIDE).
+ */
+static bool is_proportional(SchedPolicy policy) {
+    return policy == POLICY_LOTTERY || policy == POLICY_STRIDE;
+}
+
+/**
+ * Verifica se a política consome o quantum a cada tick executado.
+ */
+static bool uses_quantum(SchedPolicy policy) {
+    return policy == POLICY_RR || is_proportional(policy);
+}
+
+/**
+ * Converte a semente do usuário no estado inicial do gerador (nunca zero).
+ */
+static unsigned long long seed_to_state(unsigned int seed) {
+    unsigned long long state = (seed + 1ULL) * 0x9E3779B97F4A7C15ULL;
+    return state ? state : 0x9E3779B97F4A7C15ULL;
+}
+
+/**
+ * Próximo número pseudoaleatório (xorshift64*). O estado fica no simulador,
+ * então a sequência de sorteios depende só da semente e volta junto com os
+ * snapshots ao retroceder.
+ */
+static unsigned long long next_random(Simulator* sim) {
+    unsigned long long x = sim->rng_state;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    sim->rng_state = x;
+    return x * 0x2545F4914F6CDD1DULL;
+}
+
+/**
+ * Insere uma tarefa pronta nas estruturas da política atual: heap de
+ * prontas (EDF por prazo, STRIDE por passagem) e árvore de bilhetes.
+ */
+static void enqueue_ready(Simulator* sim, int idx) {
+    TCB* task = &sim->tasks[idx];
+
+    if (sim->policy == POLICY_EDF) {
+        task_heap_push(&sim->ready_heap, idx, edf_key(task));
+    } else if (sim->policy == POLICY_STRIDE) {
+        task_heap_push(&sim->ready_heap, idx, task->pass);
+    }
+    if (is_proportional(sim->policy)) {
+        ticket_tree_set(&sim->tickets, idx, task->tickets);
+    }
+}
+
+/**
+ * Inicializa a contabilidade proporcional de uma tarefa que acaba de ficar
+ * pronta: a passagem parte da passagem global (relógio de fatia × STRIDE1)
+ * mais um passo, e a fatia de direito passa a ser medida a partir daqui.
+ */
+static void admit_ready(Simulator* sim, TCB* task) {
+    if (!is_proportional(sim->policy)) return;
+    task->pass = (long long)(sim->share_clock * STRIDE1) + STRIDE1 / task->tickets;
+    task->share_mark = sim->share_clock;
+}
+
+/**
+ * Fatia de CPU (em ticks) a que a tarefa teve direito: intervalos já
+ * encerrados mais o intervalo em aberto, se ela ainda disputa a CPU.
+ * Enquanto pronta, a cada tick ela tem direito a bilhetes/total_pronto,
+ * que é exatamente o avanço de share_clock multiplicado pelos bilhetes.
+ */
+static double task_entitled(Simulator* sim, const TCB* task) {
+    int idx = (int)(task - sim->tasks);
+    double entitled = task->entitled;
+    if (ticket_tree_get(&sim->tickets, idx) > 0) {
+        entitled += task->tickets * (sim->share_clock - task->share_mark);
+    }
+    return entitled;
+}
+
+/**
+ * Recalcula as estruturas derivadas do array de tarefas (contador e resumo
+ * das concluídas, cursor de chegadas, heap de prontas, liberações
+ * periódicas e slots livres) para o tick atual. Usado após restaurar um
+ * snapshot.
+ */
+static void rebuild_scheduler_state(Simulator* sim) {
+    sim->completed_count = 0;
+    task_summary_reset(&sim->summary);
+    for (int i = 0; i < sim->static_count; i++) {
+        TCB* t = &sim->tasks[i];
+        if (t->state == STATE_TERMINATED) {
+            sim->completed_count++;
+            task_summary_add(&sim->summary, t->turnaround_time, t->waiting_time, t->response_time);
+        }
+    }
+
+    // Chegadas com instante < tick atual já foram processadas
+    sim->next_arrival = 0;
+    while (sim->clock.current_tick > 0 &&
+           sim->next_arrival < sim->static_count &&
+           sim->tasks[sim->arrival_order[sim->next_arrival]].arrival_time <
+               sim->clock.current_tick) {
+        sim->next_arrival++;
+    }
+
+    task_heap_clear(&sim->ready_heap);
+    ticket_tree_clear(&sim->tickets);
+    for (int i = 0; i < sim->next_arrival; i++) {
+        int idx = sim->arrival_order[i];
+        if (sim->tasks[idx].state != STATE_TERMINATED) {
+            enqueue_ready(sim, idx);
+        }
+    }
+
+    // Jobs vivos e slots livres
+    sim->live_jobs = 0;
+    task_heap_clear(&sim->free_slots);
+    for (int i = sim->static_count; i < sim->task_count; i++) {
+        TCB* job = &sim->tasks[i];
+        if (job->state == STATE_FREE) {
+            task_heap_push(&sim->free_slots, i, i);
+        } else if (job->state != STATE_TERMINATED) {
+            sim->live_jobs++;
+            enqueue_ready(sim, i);
+        }
+    }
+
+    // Próximas liberações
+    task_heap_clear(&sim->release_heap);
+    for (int p = 0; p < sim->periodic_count; p++) {
+        if (sim->periodic[p].next_release < sim->horizon) {
+            task_heap_push(&sim->release_heap, p, sim->periodic[p].next_release);
+        }
+    }
+}
+
+/**
+ * Horizonte automático para tarefas periódicas: maior fase mais um
+ * hiperperíodo (MMC dos períodos), limitado a MAX_AUTO_HORIZON.
+ */
+static int auto_horizon(const PeriodicTask* periodic, int count) {
+    long long hyper = 1;
+    int max_phase = 0;
+
+    for (int p = 0; p < count; p++) {
+        long long a = hyper, b = periodic[p].period;
+        while (b != 0) {
+            long long r = a % b;
+            a = b;
+            b = r;
+        }
+        hyper = hyper / a * periodic[p].period;
+        if (hyper > MAX_AUTO_HORIZON) hyper = MAX_AUTO_HORIZON;
+        if (periodic[p].phase > max_phase) max_phase = periodic[p].phase;
+    }
+
+    long long horizon = max_phase + hyper;
+    return (horizon > MAX_AUTO_HORIZON) ? MAX_AUTO_HORIZON : (int)horizon;
+}
+
+/**
+ * Linha do Gantt de um slot: as tarefas comuns ocupam as primeiras linhas,
+ * na ordem do arquivo, e os jobs usam a linha da sua tarefa periódica.
+ */
+static int task_row(const Simulator* sim, const TCB* t) {
+    return (t->periodic_idx >= 0) ? sim->static_count + t->periodic_idx : (int)(t - sim->tasks);
+}
+
+/**
+ * Id (da configuração) da tarefa da linha row, usado nos rótulos "T<id>"
+ */
+static int row_id(const Simulator* sim, int row) {
+    return (row < sim->static_count) ? sim->tasks[row].id : sim->periodic[row - sim->static_count].id;
+}
+
+/**
+ * Prepara o simulador para uma nova execução com a configuração dada,
+ * reaproveitando todos os buffers na capacidade que já atingiram. Depois
+ * da primeira execução, repetir uma simulação não aloca memória (com o
+ * histórico desativado).
+ */
+void reset_simulator(Simulator* sim, SimConfig* config) {
+    arena_reset(&sim->arena);
+    arena_reset(&sim->scratch);
 
     // Inicializar relógio
     sim->clock.current_tick = 0;
     sim->clock.quantum_size = config->quantum;
 
-    // Copiar tarefas
+    // Copiar tarefas (os slots de jobs periódicos são criados sob demanda)
     sim->task_count = config->task_count;
-    sim->tasks = malloc(sim->task_count * sizeof(TCB));
+    sim->static_count = config->task_count;
+    if (sim->task_capacity < config->task_count || sim->task_capacity == 0) {
+        sim->task_capacity = (config->task_count > 0) ? config->task_count : 1;
+        sim->tasks = realloc(sim->tasks, sim->task_capacity * sizeof(TCB));
+    }
     memcpy(sim->tasks, config->tasks, sim->task_count * sizeof(TCB));
 
     // Inicializar quantum das tarefas
@@ -391,20 +988,153 @@ Simulator* create_simulator(SimConfig* config) {
 
     // Copiar algoritmo
     strncpy(sim->algorithm, config->algorithm, sizeof(sim->algorithm) - 1);
+    sim->algorithm[sizeof(sim->algorithm) - 1] = '\0';
+    sim->policy = parse_policy(sim->algorithm);
     sim->current_task = NULL;
 
+    // Ordem de chegada (permite processar chegadas sem varrer todas as tarefas)
+    ArrivalKey* keys = arena_alloc(&sim->scratch, sim->task_count * sizeof(ArrivalKey));
+    sim->arrival_order = arena_alloc(&sim->arena, sim->task_count * sizeof(int));
+    for (int i = 0; i < sim->task_count; i++) {
+        keys[i].arrival = sim->tasks[i].arrival_time;
+        keys[i].index = i;
+    }
+    qsort(keys, sim->task_count, sizeof(ArrivalKey), compare_arrival);
+    for (int i = 0; i < sim->task_count; i++) {
+        sim->arrival_order[i] = keys[i].index;
+    }
+    arena_reset(&sim->scratch);
+
+    sim->next_arrival = 0;
+    sim->completed_count = 0;
+    task_summary_reset(&sim->summary);
+    task_summary_reset(&sim->job_summary);
+    task_heap_clear(&sim->ready_heap);
+    task_heap_reserve(&sim->ready_heap, sim->task_count);
+
+    // Compartilhamento proporcional
+    ticket_tree_clear(&sim->tickets);
+    ticket_tree_reserve(&sim->tickets, sim->task_count);
+    sim->rng_state = seed_to_state(config->seed);
+    sim->share_clock = 0.0;
+
+    // Custo de troca de contexto
+    sim->switch_cost = config->switch_cost;
+    sim->cache_penalty = config->cache_penalty;
+    sim->overhead_remaining = 0;
+    sim->switch_count = 0;
+    sim->overhead_ticks = 0;
+
+    // Tarefas periódicas
+    sim->periodic_count = config->periodic_count;
+    sim->periodic = arena_alloc(&sim->arena, sim->periodic_count * sizeof(PeriodicTask));
+    if (sim->periodic_count > 0) {
+        memcpy(sim->periodic, config->periodic,
+               sim->periodic_count * sizeof(PeriodicTask));
+    }
+    sim->horizon = config->horizon;
+    if (sim->horizon <= 0) {
+        sim->horizon = auto_horizon(sim->periodic, sim->periodic_count);
+    }
+    sim->live_jobs = 0;
+    task_heap_clear(&sim->release_heap);
+    task_heap_reserve(&sim->release_heap, sim->periodic_count);
+    task_heap_clear(&sim->free_slots);
+    for (int p = 0; p < sim->periodic_count; p++) {
+        sim->periodic[p].next_release = sim->periodic[p].phase;
+        if (sim->periodic[p].next_release < sim->horizon) {
+            task_heap_push(&sim->release_heap, p, sim->periodic[p].next_release);
+        }
+    }
+    sim->row_count = sim->static_count + sim->periodic_count;
+
+    // Perdas de prazo e Gantt (o Gantt mantém a capacidade)
+    sim->miss_count = 0;
+    sim->gantt.count = 0;
+    gantt_index_reset(&sim->gantt.index, sim->row_count);
+
+    // Linhas na ordem do arquivo (comuns e depois periódicas), rotuladas
+    // com o id; o mapa resolve um id (qualquer número, como um PID) para a
+    // sua linha. Um id repetido é encontrado na primeira linha que o usa.
+    task_map_reset(&sim->id_rows, sim->row_count);
+    gantt_palette_reset(&sim->gantt.palette, sim->row_count);
+    for (int row = 0; row < sim->row_count; row++) {
+        const char* color = (row < sim->static_count) ? sim->tasks[row].color
+                                                       : sim->periodic[row - sim->static_count].color;
+        task_map_put(&sim->id_rows, row_id(sim, row), row);
+        gantt_palette_set(&sim->gantt.palette, row, color);
+        gantt_palette_set_label(&sim->gantt.palette, row, row_id(sim, row));
+    }
+    gantt_palette_set(&sim->gantt.palette, sim->row_count, OVERHEAD_COLOR);
+
+    // Histórico: os carimbos não são zerados, frame_serial continua crescendo
+    sim->history_enabled = config->history;
+    journal_clear(&sim->history);
+    sim->touched_count = 0;
+    sim->touch_images_size = 0;
+    sim->periodic_stamp = arena_calloc(&sim->arena, sim->periodic_count, sizeof(int));
+    sim->frame_task_count = sim->task_count;
+    for (int i = 0; i < sim->keyframe_count; i++) {
+        free(sim->keyframes[i].tasks);
+        free(sim->keyframes[i].periodic);
+        free(sim->keyframes[i].job_summary);
+    }
+    sim->keyframe_count = 0;
+    sim->keyframe_bytes = 0;
+    sim->history_file_end = 0;
+    if (config->history && config->disk_history && !sim->history_file) {
+        sim->history_file = tmpfile();
+        if (!sim->history_file) {
+            printf("Aviso: Não foi possível criar o arquivo de histórico; usando memória\n");
+        }
+    }
+    // Em disco a memória não limita os quadros-chave: usar intervalo curto
+    sim->keyframe_interval = sim->history_file ? DISK_KEYFRAME_INTERVAL : KEYFRAME_INTERVAL;
+}
+
+/**
+ * Cria e inicializa uma nova instância do simulador.
+ * Os buffers começam vazios e são dimensionados por reset_simulator.
+ */
+Simulator* create_simulator(SimConfig* config) {
+    Simulator* sim = malloc(sizeof(Simulator));
+    if (!sim) return NULL;
+
+    // Arenas: tamanhos fixos da simulação e temporários dos renderizadores
+    arena_init(&sim->arena, 0);
+    arena_init(&sim->scratch, 0);
+
+    sim->tasks = NULL;
+    sim->task_capacity = 0;
+    task_heap_init(&sim->ready_heap, 0);
+    ticket_tree_init(&sim->tickets, 0);
+    task_heap_init(&sim->release_heap, 0);
+    task_heap_init(&sim->free_slots, 0);
+    task_map_init(&sim->id_rows);
+
     // Inicializar Gantt
-    sim->gantt_capacity = 1000;
-    sim->gantt_entries = malloc(sim->gantt_capacity * sizeof(GanttEntry));
-    sim->gantt_count = 0;
+    sim->gantt.capacity = 1000;
+    sim->gantt.entries = malloc(sim->gantt.capacity * sizeof(GanttEntry));
+    gantt_index_init(&sim->gantt.index);
+    gantt_palette_init(&sim->gantt.palette);
 
     // Inicializar histórico
-    sim->history_capacity = MAX_HISTORY;
-    sim->history = malloc(sim->history_capacity * sizeof(Snapshot));
-    sim->history_count = 0;
+    journal_init(&sim->history, sizeof(Snapshot));
+    sim->touched = NULL;
+    sim->touched_capacity = 0;
+    sim->touch_images = NULL;
+    sim->touch_images_capacity = 0;
+    sim->stamp_capacity = 0;
+    sim->task_stamp = NULL;
+    sim->frame_serial = 0;
+    sim->keyframes = NULL;
+    sim->keyframe_count = 0;
+    sim->keyframe_capacity = 0;
+    sim->history_file = NULL;
 
     sim->verbose = true;
 
+    reset_simulator(sim, config);
     return sim;
 }
 
@@ -415,14 +1145,29 @@ void destroy_simulator(Simulator* sim) {
     if (!sim) return;
 
     // Liberar histórico
-    for (int i = 0; i < sim->history_count; i++) {
-        free(sim->history[i].tasks);
-        free(sim->history[i].gantt_entries);
+    journal_free(&sim->history);
+    free(sim->touched);
+    free(sim->touch_images);
+    free(sim->task_stamp);
+    for (int i = 0; i < sim->keyframe_count; i++) {
+        free(sim->keyframes[i].tasks);
+        free(sim->keyframes[i].periodic);
+        free(sim->keyframes[i].job_summary);
     }
-    free(sim->history);
+    free(sim->keyframes);
+    if (sim->history_file) fclose(sim->history_file);
 
     free(sim->tasks);
-    free(sim->gantt_entries);
+    task_heap_free(&sim->ready_heap);
+    ticket_tree_free(&sim->tickets);
+    task_heap_free(&sim->release_heap);
+    task_heap_free(&sim->free_slots);
+    task_map_free(&sim->id_rows);
+    free(sim->gantt.entries);
+    gantt_index_free(&sim->gantt.index);
+    gantt_palette_free(&sim->gantt.palette);
+    arena_free(&sim->arena);
+    arena_free(&sim->scratch);
     free(sim);
 }
 
@@ -431,127 +1176,589 @@ void destroy_simulator(Simulator* sim) {
 // =============================================================================
 
 /**
- * Salva um snapshot do estado atual do sistema.
- * Permite retroceder a simulação posteriormente.
+ * Endereço e tamanho de um objeto registrado no diário.
  */
-void save_snapshot(Simulator* sim) {
-    if (sim->history_count >= sim->history_capacity) {
-        // Histórico cheio - remover snapshot mais antigo
-        free(sim->history[0].tasks);
-        free(sim->history[0].gantt_entries);
-        memmove(&sim->history[0], &sim->history[1],
-                (sim->history_count - 1) * sizeof(Snapshot));
-        sim->history_count--;
+static unsigned char* history_object(Simulator* sim, int kind, int index, size_t* size) {
+    if (kind == HIST_JOB_SUMMARY) {
+        *size = sizeof(TaskSummary);
+        return (unsigned char*)&sim->job_summary;
     }
-
-    Snapshot* snap = &sim->history[sim->history_count];
-
-    snap->tick = sim->clock.current_tick;
-    snap->tasks = copy_tasks(sim->tasks, sim->task_count);
-    snap->task_count = sim->task_count;
-    snap->current_task_id = sim->current_task ? sim->current_task->id : -1;
-    snap->gantt_entries = copy_gantt(sim->gantt_entries, sim->gantt_count);
-    snap->gantt_count = sim->gantt_count;
-
-    sim->history_count++;
+    if (kind == HIST_PERIODIC) {
+        *size = sizeof(PeriodicTask);
+        return (unsigned char*)&sim->periodic[index];
+    }
+    *size = sizeof(TCB);
+    return (unsigned char*)&sim->tasks[index];
 }
 
 /**
- * Restaura o estado do sistema para um snapshot específico.
- *
- * @param sim Simulador
- * @param target_tick Tick para o qual retroceder
- * @return true se conseguiu retroceder, false caso contrário
+ * Registra que um objeto será alterado no tick atual, guardando sua imagem
+ * do início do tick (apenas na primeira vez em cada quadro). Deve ser
+ * chamada antes de qualquer escrita no TCB ou na tarefa periódica.
+ * Slots criados durante o quadro não precisam de imagem: desfazer o quadro
+ * volta task_count para o valor do cabeçalho.
  */
-bool restore_snapshot(Simulator* sim, int target_tick) {
-    // Encontrar o snapshot mais próximo do tick desejado
-    int best_idx = -1;
-    for (int i = sim->history_count - 1; i >= 0; i--) {
-        if (sim->history[i].tick <= target_tick) {
-            best_idx = i;
-            break;
+void history_touch(Simulator* sim, int kind, int index) {
+    if (!sim->history_enabled || index < 0) return;
+
+    int* stamp;
+    if (kind == HIST_TASK) {
+        if (index >= sim->frame_task_count) return;
+        if (index >= sim->stamp_capacity) {
+            int old_capacity = sim->stamp_capacity;
+            sim->stamp_capacity = (old_capacity > 0) ? old_capacity : 64;
+            while (sim->stamp_capacity <= index) sim->stamp_capacity *= 2;
+            sim->task_stamp = realloc(sim->task_stamp, sim->stamp_capacity * sizeof(int));
+            memset(sim->task_stamp + old_capacity, 0,
+                   (sim->stamp_capacity - old_capacity) * sizeof(int));
         }
+        stamp = &sim->task_stamp[index];
+    } else if (kind == HIST_JOB_SUMMARY) {
+        stamp = &sim->job_summary_stamp;
+    } else {
+        stamp = &sim->periodic_stamp[index];
     }
+    if (*stamp == sim->frame_serial) return;
+    *stamp = sim->frame_serial;
 
-    if (best_idx < 0) {
-        printf("Erro: Não há histórico para o tick %d\n", target_tick);
-        return false;
+    size_t size;
+    unsigned char* obj = history_object(sim, kind, index, &size);
+
+    if (sim->touched_count >= sim->touched_capacity) {
+        sim->touched_capacity = (sim->touched_capacity > 0) ? sim->touched_capacity * 2 : 16;
+        sim->touched = realloc(sim->touched, sim->touched_capacity * sizeof(HistoryTouch));
+    }
+    if (sim->touch_images_size + size > sim->touch_images_capacity) {
+        size_t capacity = (sim->touch_images_capacity > 0) ? sim->touch_images_capacity : 4096;
+        while (capacity < sim->touch_images_size + size) capacity *= 2;
+        sim->touch_images = realloc(sim->touch_images, capacity);
+        sim->touch_images_capacity = capacity;
     }
 
-    Snapshot* snap = &sim->history[best_idx];
+    HistoryTouch* touch = &sim->touched[sim->touched_count++];
+    touch->kind = kind;
+    touch->index = index;
+    touch->image = sim->touch_images_size;
+    memcpy(sim->touch_images + touch->image, obj, size);
+    sim->touch_images_size += size;
+}
 
-    // Restaurar estado
-    sim->clock.current_tick = snap->tick;
-    memcpy(sim->tasks, snap->tasks, snap->task_count * sizeof(TCB));
+/**
+ * Preenche um Snapshot com o estado escalar atual.
+ */
+static void fill_snapshot(Simulator* sim, Snapshot* snap) {
+    memset(snap, 0, sizeof(Snapshot));
 
-    // Restaurar current_task
-    sim->current_task = NULL;
-    if (snap->current_task_id >= 0) {
-        for (int i = 0; i < sim->task_count; i++) {
-            if (sim->tasks[i].id == snap->current_task_id) {
-                sim->current_task = &sim->tasks[i];
-                break;
-            }
-        }
-    }
+    snap->tick = sim->clock.current_tick;
+    snap->task_count = sim->task_count;
+    snap->current_task_idx = sim->current_task ? (int)(sim->current_task - sim->tasks) : -1;
+    snap->gantt_count = sim->gantt.count;
+    snap->gantt_last_end = gantt_log_last_end(&sim->gantt);
+    snap->miss_count = sim->miss_count;
+    snap->rng_state = sim->rng_state;
+    snap->share_clock = sim->share_clock;
+    snap->overhead_remaining = sim->overhead_remaining;
+    snap->switch_count = sim->switch_count;
+    snap->overhead_ticks = sim->overhead_ticks;
+}
 
-    // Restaurar Gantt
-    sim->gantt_count = snap->gantt_count;
-    if (snap->gantt_count > 0) {
-        memcpy(sim->gantt_entries, snap->gantt_entries,
-               snap->gantt_count * sizeof(GanttEntry));
+/**
+ * Descarta os quadros-chave a partir da posição 'from'.
+ */
+static void drop_keyframes(Simulator* sim, int from) {
+    for (int i = from; i < sim->keyframe_count; i++) {
+        // O arquivo volta a crescer a partir do primeiro quadro descartado
+        if (sim->keyframes[i].offset >= 0 && sim->keyframes[i].offset < sim->history_file_end) {
+            sim->history_file_end = sim->keyframes[i].offset;
+        }
+        free(sim->keyframes[i].tasks);
+        free(sim->keyframes[i].periodic);
+        free(sim->keyframes[i].job_summary);
+        sim->keyframe_bytes -= sim->keyframes[i].bytes;
     }
+    if (from < sim->keyframe_count) sim->keyframe_count = from;
+}
 
-    // Remover snapshots posteriores
-    for (int i = best_idx + 1; i < sim->history_count; i++) {
-        free(sim->history[i].tasks);
-        free(sim->history[i].gantt_entries);
+/**
+ * Acrescenta as cópias de um quadro-chave ao arquivo de histórico.
+ * @return true se conseguiu gravar tudo
+ */
+static bool spill_keyframe(Simulator* sim, Keyframe* kf) {
+    FILE* f = sim->history_file;
+    kf->offset = sim->history_file_end;
+
+    if (fseek(f, kf->offset, SEEK_SET) != 0 ||
+        fwrite(sim->tasks, sizeof(TCB), sim->task_count, f) != (size_t)sim->task_count ||
+        fwrite(sim->periodic, sizeof(PeriodicTask), sim->periodic_count, f) !=
+            (size_t)sim->periodic_count ||
+        fwrite(&sim->job_summary, sizeof(TaskSummary), 1, f) != 1) {
+        kf->offset = -1;
+        return false;
     }
-    sim->history_count = best_idx + 1;
 
-    printf("Estado restaurado para o tick %d\n", snap->tick);
+    sim->history_file_end = ftell(f);
     return true;
 }
 
-// =============================================================================
-// GANTT CHART
-// =============================================================================
-
 /**
- * Adiciona uma entrada ao registro do Gantt.
+ * Lê as cópias de um quadro-chave do arquivo de histórico via mmap.
+ * @return true se conseguiu ler
  */
-void add_gantt_entry(Simulator* sim, int task_id, int start, int end, const char* color) {
-    // Expandir array se necessário
-    if (sim->gantt_count >= sim->gantt_capacity) {
-        sim->gantt_capacity *= 2;
-        sim->gantt_entries = realloc(sim->gantt_entries,
-                                     sim->gantt_capacity * sizeof(GanttEntry));
+static bool load_spilled_keyframe(Simulator* sim, const Keyframe* kf) {
+    size_t tasks_bytes = kf->state.task_count * sizeof(TCB);
+    size_t periodic_bytes = sim->periodic_count * sizeof(PeriodicTask);
+
+    // mmap exige deslocamento alinhado à página
+    fflush(sim->history_file);
+    long page = sysconf(_SC_PAGESIZE);
+    long base = kf->offset - kf->offset % page;
+    size_t skip = kf->offset - base;
+    size_t length = skip + tasks_bytes + periodic_bytes + sizeof(TaskSummary);
+
+    unsigned char* map = mmap(NULL, length, PROT_READ, MAP_PRIVATE,
+                              fileno(sim->history_file), base);
+    if (map == MAP_FAILED) {
+        printf("Erro: Falha ao ler o histórico do tick %d\n", kf->state.tick);
+        return false;
     }
 
-    GanttEntry* entry = &sim->gantt_entries[sim->gantt_count++];
-    entry->task_id = task_id;
-    entry->start_time = start;
-    entry->end_time = end;
-    strncpy(entry->color, color, sizeof(entry->color) - 1);
+    memcpy(sim->tasks, map + skip, tasks_bytes);
+    if (periodic_bytes > 0) {
+        memcpy(sim->periodic, map + skip + tasks_bytes, periodic_bytes);
+    }
+    memcpy(&sim->job_summary, map + skip + tasks_bytes + periodic_bytes, sizeof(TaskSummary));
+    munmap(map, length);
+    return true;
 }
 
-// =============================================================================
-// ALGORITMOS DE ESCALONAMENTO
-// =============================================================================
-
 /**
- * Verifica se todas as tarefas terminaram.
+ * Guarda um quadro-chave do estado atual. O diário passa a começar aqui:
+ * quadros mais antigos são cobertos pelo quadro-chave.
+ * Se a memória dos quadros-chave passar do limite, o intervalo dobra e
+ * os que não são múltiplos dele são descartados, de modo que a memória e
+ * o tempo de reexecução até qualquer tick continuam limitados.
  */
-bool all_tasks_completed(Simulator* sim) {
-    for (int i = 0; i < sim->task_count; i++) {
-        if (sim->tasks[i].state != STATE_TERMINATED) {
-            return false;
+static void save_keyframe(Simulator* sim) {
+    if (sim->keyframe_count >= sim->keyframe_capacity) {
+        sim->keyframe_capacity = (sim->keyframe_capacity > 0) ? sim->keyframe_capacity * 2 : 16;
+        sim->keyframes = realloc(sim->keyframes, sim->keyframe_capacity * sizeof(Keyframe));
+    }
+
+    Keyframe* kf = &sim->keyframes[sim->keyframe_count++];
+    fill_snapshot(sim, &kf->state);
+    kf->tasks = NULL;
+    kf->periodic = NULL;
+    kf->job_summary = NULL;
+    kf->bytes = 0;
+    kf->offset = -1;
+
+    // Em disco só o índice fica em memória; se a gravação falhar, copiar
+    if (!sim->history_file || !spill_keyframe(sim, kf)) {
+        kf->tasks = copy_tasks(sim->tasks, sim->task_count);
+        kf->bytes = sim->task_count * sizeof(TCB);
+        if (sim->periodic_count > 0) {
+            kf->periodic = malloc(sim->periodic_count * sizeof(PeriodicTask));
+            memcpy(kf->periodic, sim->periodic, sim->periodic_count * sizeof(PeriodicTask));
+            kf->bytes += sim->periodic_count * sizeof(PeriodicTask);
         }
+        kf->job_summary = malloc(sizeof(TaskSummary));
+        *kf->job_summary = sim->job_summary;
+        kf->bytes += sizeof(TaskSummary);
     }
-    return true;
-}
+    sim->keyframe_bytes += kf->bytes;
 
-/**
+    journal_clear(&sim->history);
+
+    // Espaçar: manter apenas os múltiplos do novo intervalo (e o mais recente)
+    while (sim->keyframe_bytes > KEYFRAME_BUDGET && sim->keyframe_count > MIN_KEYFRAMES) {
+        sim->keyframe_interval *= 2;
+
+        int kept = 0;
+        for (int i = 0; i < sim->keyframe_count; i++) {
+            Keyframe* k = &sim->keyframes[i];
+            if (k->state.tick % sim->keyframe_interval == 0 || i == sim->keyframe_count - 1) {
+                sim->keyframes[kept++] = *k;
+            } else {
+                free(k->tasks);
+                free(k->periodic);
+                free(k->job_summary);
+                sim->keyframe_bytes -= k->bytes;
+            }
+        }
+        sim->keyframe_count = kept;
+    }
+}
+
+/**
+ * Abre o quadro do tick atual no diário de histórico.
+ * Guarda apenas o estado escalar; as alterações dos objetos são
+ * acrescentadas por commit_snapshot ao fim do tick. A cada
+ * keyframe_interval ticks guarda também um quadro-chave.
+ */
+void save_snapshot(Simulator* sim) {
+    if (!sim->history_enabled) return;
+
+    if (sim->clock.current_tick % sim->keyframe_interval == 0 &&
+        (sim->keyframe_count == 0 ||
+         sim->keyframes[sim->keyframe_count - 1].state.tick < sim->clock.current_tick)) {
+        save_keyframe(sim);
+    }
+
+    Snapshot snap;
+    fill_snapshot(sim, &snap);
+
+    journal_begin_frame(&sim->history, &snap);
+
+    sim->frame_serial++;
+    sim->frame_task_count = sim->task_count;
+    sim->touched_count = 0;
+    sim->touch_images_size = 0;
+}
+
+/**
+ * Fecha o quadro do tick atual: compara cada objeto registrado com sua
+ * imagem do início do tick e grava no diário só as faixas que mudaram
+ * (em blocos de 8 bytes), com os valores antigos.
+ */
+void commit_snapshot(Simulator* sim) {
+    if (!sim->history_enabled) return;
+
+    for (int i = 0; i < sim->touched_count; i++) {
+        HistoryTouch* touch = &sim->touched[i];
+        size_t size;
+        const unsigned char* now = history_object(sim, touch->kind, touch->index, &size);
+        const unsigned char* old = sim->touch_images + touch->image;
+
+        size_t pos = 0;
+        while (pos < size) {
+            size_t chunk = (size - pos < 8) ? size - pos : 8;
+            if (memcmp(now + pos, old + pos, chunk) == 0) {
+                pos += chunk;
+                continue;
+            }
+
+            // Estender a faixa enquanto os blocos seguintes também mudaram
+            size_t start = pos;
+            pos += chunk;
+            while (pos < size) {
+                chunk = (size - pos < 8) ? size - pos : 8;
+                if (memcmp(now + pos, old + pos, chunk) == 0) break;
+                pos += chunk;
+            }
+            journal_record(&sim->history, touch->kind, touch->index,
+                           (int)start, old + start, (int)(pos - start));
+        }
+    }
+    sim->touched_count = 0;
+    sim->touch_images_size = 0;
+}
+
+/**
+ * Aplica um registro do diário (valor antigo de uma faixa de bytes).
+ */
+static void history_undo(void* ctx, int kind, int index, int offset,
+                         const void* old, int size) {
+    size_t obj_size;
+    unsigned char* obj = history_object(ctx, kind, index, &obj_size);
+    memcpy(obj + offset, old, size);
+}
+
+/**
+ * Aplica o estado escalar de um Snapshot e reconstrói as filas.
+ * Os TCBs e as tarefas periódicas já devem estar no estado do tick.
+ */
+static void apply_snapshot(Simulator* sim, const Snapshot* snap) {
+    sim->clock.current_tick = snap->tick;
+    sim->task_count = snap->task_count;
+    sim->current_task = (snap->current_task_idx >= 0) ? &sim->tasks[snap->current_task_idx] : NULL;
+
+    // Gantt: descartar entradas novas e desfazer a extensão da última
+    gantt_log_truncate(&sim->gantt, snap->gantt_count, snap->gantt_last_end);
+
+    // Registro de perdas de prazo (apenas cresce)
+    sim->miss_count = snap->miss_count;
+
+    // Sorteio, relógio de fatia e trocas de contexto
+    sim->rng_state = snap->rng_state;
+    sim->share_clock = snap->share_clock;
+    sim->overhead_remaining = snap->overhead_remaining;
+    sim->switch_count = snap->switch_count;
+    sim->overhead_ticks = snap->overhead_ticks;
+
+    // Reconstruir filas do escalonador
+    rebuild_scheduler_state(sim);
+}
+
+void simulate_tick(Simulator* sim);  // Definida no motor de simulação, abaixo
+
+/**
+ * Restaura o quadro-chave mais recente com tick <= target_tick e
+ * reexecuta a simulação (sem mensagens) até o tick desejado.
+ * Os quadros-chave posteriores são descartados e refeitos na reexecução.
+ */
+static bool replay_from_keyframe(Simulator* sim, int target_tick) {
+    // Busca binária pelo último quadro-chave com tick <= alvo
+    int lo = 0, hi = sim->keyframe_count - 1, found = -1;
+    while (lo <= hi) {
+        int mid = (lo + hi) / 2;
+        if (sim->keyframes[mid].state.tick <= target_tick) {
+            found = mid;
+            lo = mid + 1;
+        } else {
+            hi = mid - 1;
+        }
+    }
+    if (found < 0) return false;
+
+    Keyframe* kf = &sim->keyframes[found];
+    if (kf->offset >= 0) {
+        if (!load_spilled_keyframe(sim, kf)) return false;
+    } else {
+        memcpy(sim->tasks, kf->tasks, kf->state.task_count * sizeof(TCB));
+        if (sim->periodic_count > 0) {
+            memcpy(sim->periodic, kf->periodic, sim->periodic_count * sizeof(PeriodicTask));
+        }
+        sim->job_summary = *kf->job_summary;
+    }
+    apply_snapshot(sim, &kf->state);
+
+    drop_keyframes(sim, found);
+    journal_clear(&sim->history);
+
+    bool verbose = sim->verbose;
+    sim->verbose = false;
+    while (sim->clock.current_tick < target_tick) {
+        simulate_tick(sim);
+    }
+    sim->verbose = verbose;
+    return true;
+}
+
+/**
+ * Restaura o estado do sistema para um tick anterior.
+ * Ticks ainda cobertos pelo diário são restaurados desfazendo quadros do
+ * mais recente para o mais antigo; os anteriores, a partir do quadro-chave
+ * mais próximo com reexecução determinística. Em ambos os casos o custo é
+ * limitado pelo intervalo entre quadros-chave.
+ *
+ * @param sim Simulador
+ * @param target_tick Tick para o qual retroceder
+ * @return true se conseguiu retroceder, false caso contrário
+ */
+bool restore_snapshot(Simulator* sim, int target_tick) {
+    if (!sim->history_enabled) {
+        printf("Erro: Histórico desativado\n");
+        return false;
+    }
+
+    const Snapshot* first = journal_frame_header(&sim->history, 0);
+
+    if (first && first->tick <= target_tick) {
+        // Desfazer quadros até chegar ao início do tick desejado
+        Snapshot snap;
+        do {
+            memcpy(&snap, journal_frame_header(&sim->history, sim->history.frame_count - 1),
+                   sizeof(Snapshot));
+            journal_undo_frame(&sim->history, history_undo, sim);
+        } while (snap.tick > target_tick && sim->history.frame_count > 0);
+
+        apply_snapshot(sim, &snap);
+    } else if (!replay_from_keyframe(sim, target_tick)) {
+        printf("Erro: Não há histórico para o tick %d\n", target_tick);
+        return false;
+    }
+
+    printf("Estado restaurado para o tick %d\n", sim->clock.current_tick);
+    return true;
+}
+
+// =============================================================================
+// GANTT CHART
+// =============================================================================
+
+/**
+ * Adiciona uma entrada ao registro do Gantt.
+ */
+void add_gantt_entry(Simulator* sim, int task_id, int start, int end) {
+    // Expandir array se necessário
+    if (sim->gantt.count >= sim->gantt.capacity) {
+        sim->gantt.capacity *= 2;
+        sim->gantt.entries = realloc(sim->gantt.entries,
+                                     sim->gantt.capacity * sizeof(GanttEntry));
+    }
+
+    GanttEntry* entry = &sim->gantt.entries[sim->gantt.count++];
+    entry->task_id = task_id;
+    entry->start_time = start;
+    entry->end_time = end;
+    gantt_index_append(&sim->gantt.index, sim->gantt.entries, sim->gantt.count - 1);
+}
+
+/**
+ * Registra um tick do Gantt para a linha task_id no tick atual: estende a
+ * última entrada se ela for da mesma linha e terminar agora, ou cria outra.
+ */
+static void record_gantt_tick(Simulator* sim, int task_id) {
+    int tick = sim->clock.current_tick;
+
+    if (sim->gantt.count > 0 &&
+        sim->gantt.entries[sim->gantt.count - 1].task_id == task_id &&
+        sim->gantt.entries[sim->gantt.count - 1].end_time == tick) {
+        sim->gantt.entries[sim->gantt.count - 1].end_time++;
+    } else {
+        add_gantt_entry(sim, task_id, tick, tick + 1);
+    }
+}
+
+// =============================================================================
+// PRAZOS (TEMPO REAL)
+// =============================================================================
+
+/**
+ * Registra a perda de prazo de uma tarefa recém-concluída. A perda fica na
+ * própria TCB; jobs periódicos são somados em complete_periodic_job.
+ */
+void record_deadline_miss(Simulator* sim, TCB* task) {
+    task->deadline_missed = true;
+    if (task->periodic_idx < 0) sim->miss_count++;
+}
+
+// =============================================================================
+// TAREFAS PERIÓDICAS
+// =============================================================================
+
+/**
+ * Obtém um slot de TCB para um novo job: reutiliza o slot livre de menor
+ * índice ou, se não houver, acrescenta um slot ao final do array.
+ *
+ * @return Índice do slot
+ */
+static int alloc_job_slot(Simulator* sim) {
+    int slot = task_heap_pop(&sim->free_slots);
+    if (slot >= 0) return slot;
+
+    if (sim->task_count >= sim->task_capacity) {
+        int current_idx = sim->current_task ? (int)(sim->current_task - sim->tasks) : -1;
+
+        sim->task_capacity *= 2;
+        sim->tasks = realloc(sim->tasks, sim->task_capacity * sizeof(TCB));
+
+        // O realloc pode mover o array: reapontar a tarefa atual
+        sim->current_task = (current_idx >= 0) ? &sim->tasks[current_idx] : NULL;
+    }
+    return sim->task_count++;
+}
+
+/**
+ * Instancia o próximo job da tarefa periódica p e agenda a liberação seguinte.
+ */
+void release_periodic_job(Simulator* sim, int p) {
+    PeriodicTask* pt = &sim->periodic[p];
+    int slot = alloc_job_slot(sim);
+    TCB* job = &sim->tasks[slot];
+
+    history_touch(sim, HIST_PERIODIC, p);
+    history_touch(sim, HIST_TASK, slot);
+    memset(job, 0, sizeof(TCB));
+    job->id = pt->id;
+    memcpy(job->color, pt->color, sizeof(job->color));
+    job->arrival_time = pt->next_release;
+    job->burst_time = pt->wcet;
+    job->remaining_time = pt->wcet;
+    job->priority = pt->priority;
+    job->deadline = pt->deadline;
+    job->abs_deadline = pt->next_release + pt->deadline;
+    job->start_time = -1;
+    job->quantum_remaining = sim->clock.quantum_size;
+    job->periodic_idx = p;
+    job->job_seq = pt->jobs_released++;
+    job->tickets = pt->tickets;
+    job->state = STATE_READY;
+
+    sim->live_jobs++;
+    admit_ready(sim, job);
+    enqueue_ready(sim, slot);
+
+    if (sim->verbose) {
+        printf("[Tick %3d] Job %d.%d liberado (prazo: %d)\n",
+               sim->clock.current_tick, job->id, job->job_seq, job->abs_deadline);
+    }
+
+    // Agendar a próxima liberação (nenhuma a partir do horizonte)
+    pt->next_release += pt->period;
+    if (pt->next_release < sim->horizon) {
+        task_heap_push(&sim->release_heap, p, pt->next_release);
+    } else {
+        task_heap_remove(&sim->release_heap, p);
+    }
+}
+
+/**
+ * Acumula as estatísticas de um job concluído na sua tarefa periódica e
+ * devolve o TCB à lista de slots livres.
+ */
+void complete_periodic_job(Simulator* sim, TCB* job) {
+    PeriodicTask* pt = &sim->periodic[job->periodic_idx];
+
+    history_touch(sim, HIST_PERIODIC, job->periodic_idx);
+    pt->jobs_completed++;
+    pt->total_response += job->response_time;
+    pt->total_turnaround += job->turnaround_time;
+    if (job->response_time > pt->max_response) pt->max_response = job->response_time;
+    if (pt->jobs_completed == 1 || job->lateness > pt->max_lateness) {
+        pt->max_lateness = job->lateness;
+    }
+    if (job->deadline_missed) pt->deadline_misses++;
+    pt->total_entitled += job->entitled;
+
+    history_touch(sim, HIST_JOB_SUMMARY, 0);
+    task_summary_add(&sim->job_summary, job->turnaround_time, job->waiting_time,
+                     job->response_time);
+
+    job->state = STATE_FREE;
+    sim->live_jobs--;
+    task_heap_push(&sim->free_slots, (int)(job - sim->tasks), job - sim->tasks);
+}
+
+/**
+ * Retorna o job vivo mais antigo da tarefa periódica p (NULL se nenhum).
+ */
+TCB* periodic_live_job(Simulator* sim, int p) {
+    TCB* oldest = NULL;
+    for (int i = sim->static_count; i < sim->task_count; i++) {
+        TCB* job = &sim->tasks[i];
+        if (job->periodic_idx == p &&
+            job->state != STATE_FREE && job->state != STATE_TERMINATED &&
+            (!oldest || job->job_seq < oldest->job_seq)) {
+            oldest = job;
+        }
+    }
+    return oldest;
+}
+
+// =============================================================================
+// ALGORITMOS DE ESCALONAMENTO
+// =============================================================================
+
+/**
+ * Verifica se todas as tarefas terminaram.
+ */
+bool all_tasks_completed(Simulator* sim) {
+    return sim->completed_count >= sim->static_count &&
+           sim->live_jobs == 0 &&
+           sim->release_heap.count == 0;
+}
+
+/**
+ * Verifica se a tarefa pode ser escolhida pelo escalonador: já chegou e
+ * está pronta ou executando (exclui concluídas, bloqueadas e slots livres).
+ */
+static bool task_is_runnable(Simulator* sim, TCB* task) {
+    return task->arrival_time <= sim->clock.current_tick &&
+           (task->state == STATE_READY || task->state == STATE_RUNNING);
+}
+
+/**
  * FIFO (First In First Out) - Escalonamento por ordem de chegada.
  * Não preemptivo: a tarefa executa até terminar.
  */
@@ -570,9 +1777,7 @@ TCB* schedule_fifo(Simulator* sim) {
     for (int i = 0; i < sim->task_count; i++) {
         TCB* task = &sim->tasks[i];
 
-        if (task->arrival_time <= sim->clock.current_tick &&
-            task->state != STATE_TERMINATED &&
-            task->state != STATE_BLOCKED) {
+        if (task_is_runnable(sim, task)) {
 
             if (task->arrival_time < earliest_arrival) {
                 earliest_arrival = task->arrival_time;
@@ -615,12 +1820,11 @@ TCB* schedule_rr(Simulator* sim) {
 
         TCB* task = &sim->tasks[idx];
 
-        if (task->arrival_time <= sim->clock.current_tick &&
-            task->state != STATE_TERMINATED &&
-            task->state != STATE_BLOCKED &&
+        if (task_is_runnable(sim, task) &&
             task->remaining_time > 0) {
 
             // Resetar quantum para nova tarefa
+            history_touch(sim, HIST_TASK, idx);
             task->quantum_remaining = sim->clock.quantum_size;
             return task;
         }
@@ -640,9 +1844,7 @@ TCB* schedule_srtf(Simulator* sim) {
     for (int i = 0; i < sim->task_count; i++) {
         TCB* task = &sim->tasks[i];
 
-        if (task->arrival_time <= sim->clock.current_tick &&
-            task->state != STATE_TERMINATED &&
-            task->state != STATE_BLOCKED &&
+        if (task_is_runnable(sim, task) &&
             task->remaining_time > 0) {
 
             if (task->remaining_time < shortest_remaining) {
@@ -666,9 +1868,7 @@ TCB* schedule_priority(Simulator* sim) {
     for (int i = 0; i < sim->task_count; i++) {
         TCB* task = &sim->tasks[i];
 
-        if (task->arrival_time <= sim->clock.current_tick &&
-            task->state != STATE_TERMINATED &&
-            task->state != STATE_BLOCKED &&
+        if (task_is_runnable(sim, task) &&
             task->remaining_time > 0) {
 
             if (task->priority < highest_priority) {
@@ -681,23 +1881,79 @@ TCB* schedule_priority(Simulator* sim) {
     return next;
 }
 
+/**
+ * EDF (Earliest Deadline First) - Prazo absoluto mais próximo primeiro.
+ * Preemptivo: uma tarefa que chega com prazo mais cedo toma a CPU.
+ * As tarefas prontas ficam em um heap ordenado pelo prazo, então a escolha
+ * custa O(1) e cada chegada/término custa O(log n).
+ * Tarefas sem prazo são tratadas como de prazo infinito.
+ */
+TCB* schedule_edf(Simulator* sim) {
+    int idx = task_heap_peek(&sim->ready_heap);
+    return (idx >= 0) ? &sim->tasks[idx] : NULL;
+}
+
+/**
+ * LOTTERY - Sorteio proporcional aos bilhetes.
+ * A cada quantum sorteia-se um bilhete entre os das tarefas prontas; a
+ * árvore de Fenwick encontra o dono do bilhete em O(log n).
+ */
+TCB* schedule_lottery(Simulator* sim) {
+    if (sim->current_task &&
+        sim->current_task->state == STATE_RUNNING &&
+        sim->current_task->remaining_time > 0 &&
+        sim->current_task->quantum_remaining > 0) {
+        return sim->current_task;
+    }
+
+    if (sim->tickets.total <= 0) return NULL;
+
+    long long ticket = (long long)((next_random(sim) >> 11) % (unsigned long long)sim->tickets.total);
+    int idx = ticket_tree_find(&sim->tickets, ticket);
+    if (idx < 0) return NULL;
+
+    TCB* task = &sim->tasks[idx];
+    history_touch(sim, HIST_TASK, idx);
+    task->quantum_remaining = sim->clock.quantum_size;
+    return task;
+}
+
+/**
+ * STRIDE - Versão determinística do compartilhamento proporcional.
+ * Cada tarefa avança sua passagem em STRIDE1/bilhetes por tick executado;
+ * a cada quantum executa a de menor passagem (heap de prontas).
+ */
+TCB* schedule_stride(Simulator* sim) {
+    if (sim->current_task &&
+        sim->current_task->state == STATE_RUNNING &&
+        sim->current_task->remaining_time > 0 &&
+        sim->current_task->quantum_remaining > 0) {
+        return sim->current_task;
+    }
+
+    int idx = task_heap_peek(&sim->ready_heap);
+    if (idx < 0) return NULL;
+
+    TCB* task = &sim->tasks[idx];
+    history_touch(sim, HIST_TASK, idx);
+    task->quantum_remaining = sim->clock.quantum_size;
+    return task;
+}
+
 /**
  * Seleciona o escalonador apropriado baseado no algoritmo configurado.
  */
 TCB* schedule(Simulator* sim) {
-    if (strcmp(sim->algorithm, "FIFO") == 0) {
-        return schedule_fifo(sim);
-    } else if (strcmp(sim->algorithm, "RR") == 0) {
-        return schedule_rr(sim);
-    } else if (strcmp(sim->algorithm, "SRTF") == 0) {
-        return schedule_srtf(sim);
-    } else if (strcmp(sim->algorithm, "PRIORITY") == 0) {
-        return schedule_priority(sim);
+    switch (sim->policy) {
+        case POLICY_RR:       return schedule_rr(sim);
+        case POLICY_SRTF:     return schedule_srtf(sim);
+        case POLICY_PRIORITY: return schedule_priority(sim);
+        case POLICY_EDF:      return schedule_edf(sim);
+        case POLICY_LOTTERY:  return schedule_lottery(sim);
+        case POLICY_STRIDE:   return schedule_stride(sim);
+        case POLICY_FIFO:
+        default:              return schedule_fifo(sim);
     }
-
-    // Algoritmo desconhecido - usar FIFO como padrão
-    printf("Aviso: Algoritmo '%s' desconhecido, usando FIFO\n", sim->algorithm);
-    return schedule_fifo(sim);
 }
 
 // =============================================================================
@@ -721,21 +1977,41 @@ void simulate_tick(Simulator* sim) {
     // Salvar snapshot para permitir retrocesso
     save_snapshot(sim);
 
-    // 1. Processar chegadas de novas tarefas
-    for (int i = 0; i < sim->task_count; i++) {
-        TCB* task = &sim->tasks[i];
-        if (task->arrival_time == sim->clock.current_tick &&
-            task->state == STATE_NEW) {
+    // 1. Processar chegadas de novas tarefas (cursor sobre a ordem de chegada)
+    while (sim->next_arrival < sim->static_count) {
+        int idx = sim->arrival_order[sim->next_arrival];
+        TCB* task = &sim->tasks[idx];
+        if (task->arrival_time > sim->clock.current_tick) break;
+        sim->next_arrival++;
+
+        if (task->state == STATE_NEW) {
+            history_touch(sim, HIST_TASK, idx);
             task->state = STATE_READY;
+            admit_ready(sim, task);
             if (sim->verbose) {
                 printf("[Tick %3d] Tarefa %d chegou ao sistema\n",
                        sim->clock.current_tick, task->id);
             }
         }
+
+        if (task->state != STATE_TERMINATED) {
+            enqueue_ready(sim, idx);
+        }
     }
 
-    // 2. Selecionar próxima tarefa
-    TCB* next_task = schedule(sim);
+    // Liberar jobs periódicos cujo instante chegou
+    while (sim->release_heap.count > 0) {
+        int p = task_heap_peek(&sim->release_heap);
+        if (sim->periodic[p].next_release > sim->clock.current_tick) break;
+        release_periodic_job(sim, p);
+    }
+
+    // 2. Selecionar próxima tarefa (uma troca em andamento não é interrompida)
+    TCB* next_task = (sim->overhead_remaining > 0) ? sim->current_task : schedule(sim);
+
+    // Só a tarefa atual e a escolhida podem ser alteradas daqui em diante
+    if (sim->current_task) history_touch(sim, HIST_TASK, (int)(sim->current_task - sim->tasks));
+    if (next_task) history_touch(sim, HIST_TASK, (int)(next_task - sim->tasks));
 
     // 3. Troca de contexto se necessário
     if (next_task != sim->current_task) {
@@ -752,6 +2028,12 @@ void simulate_tick(Simulator* sim) {
 
         // Iniciar nova tarefa
         if (next_task) {
+            // Cobrar a troca: custo fixo mais cache frio se a tarefa já executou
+            bool resuming = (next_task->start_time != -1);
+            sim->switch_count++;
+            sim->overhead_remaining = sim->switch_cost;
+            if (resuming) sim->overhead_remaining += sim->cache_penalty;
+
             // Registrar tempo de resposta (primeira execução)
             if (next_task->start_time == -1) {
                 next_task->start_time = sim->clock.current_tick;
@@ -760,6 +2042,10 @@ void simulate_tick(Simulator* sim) {
             next_task->state = STATE_RUNNING;
 
             if (sim->verbose) {
+                if (sim->overhead_remaining > 0) {
+                    printf("[Tick %3d] Troca de contexto para tarefa %d (custo: %d ticks)\n",
+                           sim->clock.current_tick, next_task->id, sim->overhead_remaining);
+                }
                 printf("[Tick %3d] Executando tarefa %d (restam %d ticks)\n",
                        sim->clock.current_tick, next_task->id, next_task->remaining_time);
             }
@@ -768,30 +2054,34 @@ void simulate_tick(Simulator* sim) {
         sim->current_task = next_task;
     }
 
-    // 4. Executar tarefa atual
-    if (sim->current_task) {
+    // 4. Executar tarefa atual (ou gastar o tick com o overhead da troca)
+    if (sim->current_task && sim->overhead_remaining > 0) {
+        sim->overhead_remaining--;
+        sim->overhead_ticks++;
+        record_gantt_tick(sim, GANTT_OVERHEAD_ID);
+    } else if (sim->current_task) {
         sim->current_task->remaining_time--;
 
-        // Decrementar quantum (para RR)
-        if (strcmp(sim->algorithm, "RR") == 0) {
+        // Decrementar quantum (RR, LOTTERY, STRIDE)
+        if (uses_quantum(sim->policy)) {
             sim->current_task->quantum_remaining--;
         }
 
-        // 5. Atualizar Gantt
-        // Verificar se podemos estender a última entrada ou precisamos criar nova
-        if (sim->gantt_count > 0 &&
-            sim->gantt_entries[sim->gantt_count - 1].task_id == sim->current_task->id &&
-            sim->gantt_entries[sim->gantt_count - 1].end_time == sim->clock.current_tick) {
-            // Estender entrada existente
-            sim->gantt_entries[sim->gantt_count - 1].end_time++;
-        } else {
-            // Criar nova entrada
-            add_gantt_entry(sim, sim->current_task->id,
-                          sim->clock.current_tick,
-                          sim->clock.current_tick + 1,
-                          sim->current_task->color);
+        // Fatia proporcional: cada tarefa pronta tem direito a bilhetes/total
+        if (is_proportional(sim->policy) && sim->tickets.total > 0) {
+            sim->share_clock += 1.0 / sim->tickets.total;
+        }
+
+        // STRIDE: avançar a passagem da tarefa que executou
+        if (sim->policy == POLICY_STRIDE) {
+            TCB* running = sim->current_task;
+            running->pass += STRIDE1 / running->tickets;
+            task_heap_push(&sim->ready_heap, (int)(running - sim->tasks), running->pass);
         }
 
+        // 5. Atualizar Gantt (estende a última entrada ou cria nova)
+        record_gantt_tick(sim, task_row(sim, sim->current_task));
+
         // 6. Verificar se a tarefa terminou
         if (sim->current_task->remaining_time == 0) {
             sim->current_task->state = STATE_TERMINATED;
@@ -808,12 +2098,42 @@ void simulate_tick(Simulator* sim) {
                        sim->current_task->waiting_time);
             }
 
+            // Verificar prazo
+            TCB* done = sim->current_task;
+            if (done->abs_deadline >= 0) {
+                done->lateness = done->completion_time - done->abs_deadline;
+                if (done->lateness > 0) {
+                    record_deadline_miss(sim, done);
+                    if (sim->verbose) {
+                        printf("[Tick %3d] Tarefa %d perdeu o prazo (prazo: %d, atraso: %d)\n",
+                               sim->clock.current_tick, done->id,
+                               done->abs_deadline, done->lateness);
+                    }
+                }
+            }
+
+            // Encerrar a fatia de direito e retirar dos sorteios
+            int done_idx = (int)(done - sim->tasks);
+            done->entitled = task_entitled(sim, done);
+            ticket_tree_set(&sim->tickets, done_idx, 0);
+
+            task_heap_remove(&sim->ready_heap, done_idx);
+            if (done->periodic_idx >= 0) {
+                complete_periodic_job(sim, done);
+            } else {
+                sim->completed_count++;
+                task_summary_add(&sim->summary, done->turnaround_time, done->waiting_time,
+                                 done->response_time);
+            }
             sim->current_task = NULL;
         }
     }
 
     // 7. Incrementar tick
     sim->clock.current_tick++;
+
+    // Fechar o quadro do histórico com as alterações deste tick
+    commit_snapshot(sim);
 }
 
 // =============================================================================
@@ -835,6 +2155,57 @@ void run_complete(Simulator* sim) {
     printf("\n✓ Simulação concluída em %d ticks\n", sim->clock.current_tick);
 }
 
+/**
+ * Executa a mesma configuração 'runs' vezes, com sementes consecutivas a
+ * partir da configurada, reaproveitando o simulador (reset_simulator).
+ * Imprime uma linha por execução e a média; ao final o simulador guarda o
+ * estado da última execução.
+ */
+void run_repeated(Simulator* sim, SimConfig* config, int runs) {
+    printf("\n╔══════════════════════════════════════════════════════════════╗\n");
+    printf("║      EXECUÇÕES REPETIDAS - Algoritmo: %-10s (%6d)    ║\n", sim->algorithm, runs);
+    printf("╚══════════════════════════════════════════════════════════════╝\n\n");
+
+    unsigned int base_seed = config->seed;
+    double sum_ticks = 0.0, sum_turnaround = 0.0, sum_waiting = 0.0, sum_switches = 0.0;
+
+    for (int r = 0; r < runs; r++) {
+        if (r > 0) {
+            config->seed = base_seed + r;
+            reset_simulator(sim, config);
+        }
+        sim->verbose = false;
+        while (!all_tasks_completed(sim)) {
+            simulate_tick(sim);
+        }
+
+        // Médias das tarefas comuns (jobs periódicos têm estatística própria)
+        double turnaround = 0.0, waiting = 0.0;
+        for (int i = 0; i < sim->static_count; i++) {
+            turnaround += sim->tasks[i].turnaround_time;
+            waiting += sim->tasks[i].waiting_time;
+        }
+        if (sim->static_count > 0) {
+            turnaround /= sim->static_count;
+            waiting /= sim->static_count;
+        }
+
+        printf("Execução %4d: semente %-10u %6d ticks | turnaround %7.2f | espera %7.2f | trocas %d\n",
+               r + 1, base_seed + r, sim->clock.current_tick, turnaround, waiting,
+               sim->switch_count);
+
+        sum_ticks += sim->clock.current_tick;
+        sum_turnaround += turnaround;
+        sum_waiting += waiting;
+        sum_switches += sim->switch_count;
+    }
+
+    printf("\nMédia de %d execuções: %.1f ticks | turnaround %.2f | espera %.2f | trocas %.1f\n",
+           runs, sum_ticks / runs, sum_turnaround / runs, sum_waiting / runs,
+           sum_switches / runs);
+    config->seed = base_seed;
+}
+
 // Cores ANSI para o modo debug
 #define DBG_RESET   "\033[0m"
 #define DBG_RED     "\033[31m"
@@ -852,26 +2223,166 @@ void run_complete(Simulator* sim) {
 #define DBG_BG_BLUE   "\033[44m"
 
 /**
- * Retorna a cor ANSI correspondente a uma cor hexadecimal.
+ * Cor ANSI da linha row do Gantt, convertida uma vez na paleta
+ */
+static const char* row_ansi(const Simulator* sim, int row) {
+    return gantt_palette_color(&sim->gantt.palette, row)->ansi;
+}
+
+/**
+ * Monta o rótulo de um slot de tarefa: "T<id>" para tarefas comuns e
+ * "T<id>.<job>" para jobs periódicos.
+ */
+static void task_label(Simulator* sim, int i, char* buf, size_t size) {
+    TCB* t = &sim->tasks[i];
+    if (t->periodic_idx >= 0) {
+        snprintf(buf, size, "T%d.%d", t->id, t->job_seq);
+    } else {
+        snprintf(buf, size, "T%d", t->id);
+    }
+}
+
+/**
+ * Marca em cells[t - start] os ticks de [start, end) em que a linha row do
+ * Gantt executou, visitando só as entradas que cruzam a janela.
+ */
+static void debug_paint_row(Simulator* sim, int row, int start, int end, char* cells) {
+    const GanttIndex* index = &sim->gantt.index;
+    const GanttIndexRow* list = &index->rows[row];
+
+    memset(cells, 0, end - start);
+    for (int k = gantt_index_row_lower(index, sim->gantt.entries, row, start); k < list->count; k++) {
+        const GanttEntry* entry = &sim->gantt.entries[list->items[k]];
+        if (entry->start_time >= end) break;
+
+        int from = (entry->start_time > start) ? entry->start_time : start;
+        int to = (entry->end_time < end) ? entry->end_time : end;
+        if (from < to) memset(cells + (from - start), 1, to - from);
+    }
+}
+
+// Célula da linha do tempo do Gantt progressivo
+typedef enum {
+    GLYPH_IDLE,                 // Parada, antes da chegada ou já terminada
+    GLYPH_FUTURE,               // Ainda não simulada
+    GLYPH_RUN,                  // Executando
+    GLYPH_OVERHEAD              // Troca de contexto (linha "CS")
+} DebugGlyph;
+
+// Situação de uma linha do Gantt progressivo no tick atual
+typedef struct {
+    const char* color;          // Cor ANSI da tarefa
+    char indicator;             // Letra do estado (N, R, *, B, D, P)
+    const char* indicator_color;
+    int first_arrival;          // Antes disso a linha fica vazia
+    bool finished;              // Sem mais trabalho (futuro vazio)
+    char suffix[64];            // Texto à direita da linha ("[DONE]", "[3/10]"...)
+} DebugRowInfo;
+
+/**
+ * Levanta o estado da linha i (tarefa comum ou periódica) do Gantt progressivo.
+ */
+static void debug_row_info(Simulator* sim, int i, DebugRowInfo* info) {
+    TCB* task;
+    const PeriodicTask* pt = NULL;
+
+    if (i < sim->static_count) {
+        task = &sim->tasks[i];
+        info->first_arrival = task->arrival_time;
+        info->finished = (task->state == STATE_TERMINATED);
+    } else {
+        // Linha periódica: mostra o job vivo mais antigo, se houver
+        pt = &sim->periodic[i - sim->static_count];
+        task = periodic_live_job(sim, i - sim->static_count);
+        info->first_arrival = pt->phase;
+        info->finished = (!task && pt->next_release >= sim->horizon);
+    }
+    info->color = row_ansi(sim, i);
+
+    // Indicador de estado atual
+    switch (task ? task->state : (info->finished ? STATE_TERMINATED : STATE_FREE)) {
+        case STATE_NEW:        info->indicator = 'N'; info->indicator_color = DBG_DIM; break;
+        case STATE_READY:      info->indicator = 'R'; info->indicator_color = DBG_YELLOW; break;
+        case STATE_RUNNING:    info->indicator = '*'; info->indicator_color = DBG_GREEN; break;
+        case STATE_BLOCKED:    info->indicator = 'B'; info->indicator_color = DBG_RED; break;
+        case STATE_TERMINATED: info->indicator = 'D'; info->indicator_color = DBG_DIM; break;
+        case STATE_FREE:       info->indicator = 'P'; info->indicator_color = DBG_DIM; break;
+        default:               info->indicator = '?'; info->indicator_color = DBG_WHITE;
+    }
+
+    // Info adicional
+    char* out = info->suffix;
+    size_t size = sizeof(info->suffix);
+    int n = 0;
+    out[0] = '\0';
+    if (info->finished) {
+        n = snprintf(out, size, "  " DBG_DIM "[DONE]" DBG_RESET);
+    } else if (!task) {
+        n = snprintf(out, size, "  " DBG_DIM "[próx=%d]" DBG_RESET, pt->next_release);
+    } else if (task->state == STATE_RUNNING) {
+        n = snprintf(out, size, "  " DBG_GREEN "[%d/%d]" DBG_RESET,
+                     task->burst_time - task->remaining_time, task->burst_time);
+    } else if (task->state == STATE_READY) {
+        n = snprintf(out, size, "  " DBG_YELLOW "[wait]" DBG_RESET);
+    } else if (task->state == STATE_NEW) {
+        n = snprintf(out, size, "  " DBG_DIM "[t=%d]" DBG_RESET, task->arrival_time);
+    }
+    if (task && pt && n >= 0 && (size_t)n < size) {
+        snprintf(out + n, size - n, DBG_DIM " job %d" DBG_RESET, task->job_seq);
+    }
+}
+
+/**
+ * Célula do tick t de uma linha de tarefa (ran = a tarefa executou em t).
+ */
+static DebugGlyph debug_row_glyph(const DebugRowInfo* info, int t, int current_tick, bool ran) {
+    if (t < info->first_arrival) return GLYPH_IDLE;    // Antes da chegada
+    if (t >= current_tick) return info->finished ? GLYPH_IDLE : GLYPH_FUTURE;
+    return ran ? GLYPH_RUN : GLYPH_IDLE;
+}
+
+/**
+ * Texto (com cores ANSI) de uma célula; color é a cor da tarefa.
  */
-static const char* debug_get_color(const char* hex) {
-    if (!hex) return DBG_WHITE;
-    if (strstr(hex, "FF0000") || strstr(hex, "ff0000")) return DBG_RED;
-    if (strstr(hex, "00FF00") || strstr(hex, "00ff00")) return DBG_GREEN;
-    if (strstr(hex, "0000FF") || strstr(hex, "0000ff")) return DBG_BLUE;
-    if (strstr(hex, "FFFF00") || strstr(hex, "ffff00")) return DBG_YELLOW;
-    if (strstr(hex, "FF00FF") || strstr(hex, "ff00ff")) return DBG_MAGENTA;
-    if (strstr(hex, "00FFFF") || strstr(hex, "00ffff")) return DBG_CYAN;
-    return DBG_WHITE;
+static void debug_glyph_text(char* buf, const char* color, DebugGlyph glyph) {
+    switch (glyph) {
+        case GLYPH_FUTURE:   strcpy(buf, DBG_DIM "░" DBG_RESET); break;
+        case GLYPH_RUN:      sprintf(buf, "%s█%s", color, DBG_RESET); break;
+        case GLYPH_OVERHEAD: strcpy(buf, DBG_MAGENTA "▒" DBG_RESET); break;
+        default:             strcpy(buf, DBG_DIM "·" DBG_RESET);
+    }
+}
+
+/**
+ * Largura dos rótulos "T<id>" das linhas do Gantt do modo debug (o maior id,
+ * com pelo menos 2 dígitos)
+ */
+static int debug_label_width(Simulator* sim) {
+    int digits = 2;
+    for (int r = 0; r < sim->row_count; r++) {
+        char id[16];
+        int len = snprintf(id, sizeof(id), "%d", row_id(sim, r));
+        if (len > digits) digits = len;
+    }
+    return 1 + digits;
 }
 
 /**
  * Imprime o gráfico de Gantt progressivo no modo debug.
- * Mostra o estado atual da simulação de forma visual.
+ * Mostra o estado atual da simulação de forma visual. O quadro é montado
+ * em um buffer (text_writer) e entregue ao terminal de uma vez, em vez de
+ * um printf por célula; o diagrama e a tabela de estados fazem o mesmo.
  */
 void print_debug_gantt(Simulator* sim) {
+    TextWriter out;
+    if (!tw_attach(&out, stdout)) {
+        printf("Erro: Falha ao alocar memória\n");
+        return;
+    }
+
     int current_tick = sim->clock.current_tick;
     int display_width = 50;  // Largura máxima da visualização
+    int label_width = debug_label_width(sim);
 
     // Calcular janela de visualização
     int start_tick = 0;
@@ -884,237 +2395,498 @@ void print_debug_gantt(Simulator* sim) {
         end_tick = display_width;
     }
 
-    printf("\n");
-    printf(DBG_BOLD "╔══════════════════════════════════════════════════════════════╗\n");
-    printf("║              GANTT CHART PROGRESSIVO                         ║\n");
-    printf("╚══════════════════════════════════════════════════════════════╝" DBG_RESET "\n");
-
-    // Criar matriz de execução
-    char** matrix = malloc(sim->task_count * sizeof(char*));
-    char** task_colors = malloc(sim->task_count * sizeof(char*));
+    tw_puts(&out, "\n");
+    tw_puts(&out, DBG_BOLD "╔══════════════════════════════════════════════════════════════╗\n");
+    tw_puts(&out, "║              GANTT CHART PROGRESSIVO                         ║\n");
+    tw_puts(&out, "╚══════════════════════════════════════════════════════════════╝" DBG_RESET "\n");
 
-    for (int i = 0; i < sim->task_count; i++) {
-        matrix[i] = calloc(end_tick + 1, sizeof(char));
-        task_colors[i] = calloc((end_tick + 1) * 10, sizeof(char));
-        memset(matrix[i], ' ', end_tick);
-    }
-
-    // Preencher matriz com execuções do Gantt
-    for (int i = 0; i < sim->gantt_count; i++) {
-        GanttEntry* entry = &sim->gantt_entries[i];
-        for (int t = entry->start_time; t < entry->end_time && t <= end_tick; t++) {
-            if (entry->task_id >= 0 && entry->task_id < sim->task_count) {
-                matrix[entry->task_id][t] = '#';
-                strncpy(&task_colors[entry->task_id][t * 10], entry->color, 7);
-            }
-        }
-    }
+    // Janela mostrada: ticks [start_tick, window_end). Cada linha é pintada
+    // pelo índice do Gantt em um vetor da janela, da arena temporária (zerada
+    // a cada quadro, reaproveitando a memória).
+    int window_end = (end_tick + 1 < start_tick + display_width) ? end_tick + 1
+                                                                  : start_tick + display_width;
+    arena_reset(&sim->scratch);
+    char* cells = arena_alloc(&sim->scratch, display_width);
 
     // Escala de tempo
-    printf("\n      ");
+    tw_printf(&out, "\n%*s", label_width + 3, "");
     for (int t = start_tick; t <= end_tick && t < start_tick + display_width; t++) {
         if (t % 5 == 0) {
-            printf(DBG_DIM "%-5d" DBG_RESET, t);
+            tw_printf(&out, DBG_DIM "%-5d" DBG_RESET, t);
         }
     }
-    printf("\n");
+    tw_puts(&out, "\n");
 
     // Linha do tempo com marcador do tick atual
-    printf("      ");
+    tw_printf(&out, "%*s", label_width + 3, "");
     for (int t = start_tick; t <= end_tick && t < start_tick + display_width; t++) {
         if (t == current_tick) {
-            printf(DBG_BOLD DBG_RED "▼" DBG_RESET);
+            tw_puts(&out, DBG_BOLD DBG_RED "▼" DBG_RESET);
         } else if (t % 5 == 0) {
-            printf(DBG_DIM "│" DBG_RESET);
+            tw_puts(&out, DBG_DIM "│" DBG_RESET);
         } else {
-            printf(DBG_DIM "·" DBG_RESET);
+            tw_puts(&out, DBG_DIM "·" DBG_RESET);
         }
     }
-    printf("  " DBG_BOLD "◄ Tick %d" DBG_RESET "\n", current_tick);
+    tw_printf(&out, "  " DBG_BOLD "◄ Tick %d" DBG_RESET "\n", current_tick);
 
     // Linha divisória
-    printf("      ");
+    tw_printf(&out, "%*s", label_width + 3, "");
     for (int t = start_tick; t <= end_tick && t < start_tick + display_width; t++) {
-        printf("─");
+        tw_puts(&out, "─");
     }
-    printf("\n");
+    tw_puts(&out, "\n");
 
-    // Mostrar cada tarefa
-    for (int i = 0; i < sim->task_count; i++) {
-        TCB* task = &sim->tasks[i];
-        const char* task_color = debug_get_color(task->color);
+    // Mostrar cada linha (tarefas comuns e depois as periódicas)
+    for (int i = 0; i < sim->row_count; i++) {
+        DebugRowInfo info;
+        debug_row_info(sim, i, &info);
+
+        tw_printf(&out, "%sT%-*d%s %s%c%s ", info.color, label_width - 1, row_id(sim, i),
+                  DBG_RESET, info.indicator_color, info.indicator, DBG_RESET);
+        debug_paint_row(sim, i, start_tick, window_end, cells);
 
-        // Indicador de estado atual
-        char state_indicator;
-        const char* state_color;
-        switch (task->state) {
-            case STATE_NEW:        state_indicator = 'N'; state_color = DBG_DIM; break;
-            case STATE_READY:      state_indicator = 'R'; state_color = DBG_YELLOW; break;
-            case STATE_RUNNING:    state_indicator = '*'; state_color = DBG_GREEN; break;
-            case STATE_BLOCKED:    state_indicator = 'B'; state_color = DBG_RED; break;
-            case STATE_TERMINATED: state_indicator = 'D'; state_color = DBG_DIM; break;
-            default:               state_indicator = '?'; state_color = DBG_WHITE;
+        // Desenhar timeline da tarefa
+        for (int t = start_tick; t <= end_tick && t < start_tick + display_width; t++) {
+            char glyph[32];
+            debug_glyph_text(glyph, info.color,
+                             debug_row_glyph(&info, t, current_tick, cells[t - start_tick]));
+            tw_puts(&out, glyph);
         }
 
-        printf("%sT%-2d%s %s%c%s ", task_color, i, DBG_RESET, state_color, state_indicator, DBG_RESET);
+        // Info adicional
+        tw_puts(&out, info.suffix);
+        tw_puts(&out, "\n");
+    }
 
-        // Desenhar timeline da tarefa
+    // Linha de overhead de troca de contexto (se o custo estiver ativo)
+    if (sim->switch_cost > 0 || sim->cache_penalty > 0) {
+        debug_paint_row(sim, sim->row_count, start_tick, window_end, cells);
+
+        tw_printf(&out, DBG_MAGENTA "%-*s" DBG_RESET "   ", label_width, "CS");
         for (int t = start_tick; t <= end_tick && t < start_tick + display_width; t++) {
-            if (t < task->arrival_time) {
-                // Antes da chegada
-                printf(DBG_DIM "·" DBG_RESET);
-            } else if (t >= current_tick) {
-                // Futuro (não executado ainda)
-                if (task->state == STATE_TERMINATED) {
-                    printf(DBG_DIM "·" DBG_RESET);
-                } else {
-                    printf(DBG_DIM "░" DBG_RESET);
-                }
-            } else if (matrix[i][t] == '#') {
-                // Executando
-                printf("%s█%s", task_color, DBG_RESET);
+            if (t < current_tick && cells[t - start_tick]) {
+                tw_puts(&out, DBG_MAGENTA "▒" DBG_RESET);
             } else {
-                // Esperando
-                printf(DBG_DIM "·" DBG_RESET);
+                tw_puts(&out, DBG_DIM "·" DBG_RESET);
             }
         }
+        tw_printf(&out, "  " DBG_DIM "[%d trocas, %d ticks]" DBG_RESET "\n",
+                  sim->switch_count, sim->overhead_ticks);
+    }
 
-        // Info adicional
-        if (task->state == STATE_TERMINATED) {
-            printf("  " DBG_DIM "[DONE]" DBG_RESET);
-        } else if (task->state == STATE_RUNNING) {
-            printf("  " DBG_GREEN "[%d/%d]" DBG_RESET,
-                   task->burst_time - task->remaining_time, task->burst_time);
-        } else if (task->state == STATE_READY) {
-            printf("  " DBG_YELLOW "[wait]" DBG_RESET);
-        } else if (task->state == STATE_NEW) {
-            printf("  " DBG_DIM "[t=%d]" DBG_RESET, task->arrival_time);
+    // Linha divisória inferior
+    tw_printf(&out, "%*s", label_width + 3, "");
+    for (int t = start_tick; t <= end_tick && t < start_tick + display_width; t++) {
+        tw_puts(&out, "─");
+    }
+    tw_puts(&out, "\n");
+
+    // Legenda
+    tw_puts(&out, "\n" DBG_BOLD "Legenda:" DBG_RESET " ");
+    tw_puts(&out, "█=Executando  ");
+    tw_puts(&out, DBG_DIM "·" DBG_RESET "=Esperando  ");
+    tw_puts(&out, DBG_DIM "░" DBG_RESET "=Futuro  ");
+    tw_puts(&out, DBG_RED "▼" DBG_RESET "=Tick atual\n");
+
+    tw_puts(&out, DBG_BOLD "Estados:" DBG_RESET " ");
+    tw_puts(&out, DBG_DIM "N" DBG_RESET "=New  ");
+    tw_puts(&out, DBG_YELLOW "R" DBG_RESET "=Ready  ");
+    tw_puts(&out, DBG_GREEN "*" DBG_RESET "=Running  ");
+    tw_puts(&out, DBG_RED "B" DBG_RESET "=Blocked  ");
+    tw_puts(&out, DBG_DIM "D" DBG_RESET "=Done\n");
+    tw_close(&out);
+}
+
+// =============================================================================
+// GANTT PROGRESSIVO AO VIVO (TERMINAL INTERATIVO)
+// =============================================================================
+
+#define LIVE_WIDTH          50  // Ticks da janela (como no quadro comum)
+#define LIVE_LOOKAHEAD      5   // Ticks futuros sempre visíveis
+#define LIVE_HEADER_LINES   7   // Título (3), linha vazia, escala, marcador, divisória
+#define LIVE_FOOTER_LINES   3   // Divisória e legenda (2)
+#define LIVE_COMMAND_LINES  8   // Altura mínima da área de comandos
+#define LIVE_SUFFIX_COLS    24  // Espaço para o texto à direita das linhas
+
+/**
+ * Gantt progressivo persistente do modo debug, em terminal interativo.
+ *
+ * O quadro fica fixo no topo da tela e os comandos rolam em uma região
+ * abaixo dele (DECSTBM). Cada atualização monta o quadro inteiro em uma
+ * tela com buffer duplo (screen_buffer), que compara com o quadro anterior
+ * e manda ao terminal só as células que mudaram, em uma única escrita. A
+ * janela anda por páginas, então avançar um tick muda poucas células.
+ * Tarefas que não cabem na tela ficam fora do quadro ('v' mostra o quadro
+ * completo).
+ */
+typedef struct {
+    bool enabled;               // Entrada e saída são um terminal
+    bool on_screen;             // Layout na tela (região de rolagem ativa)
+    bool windowed;              // start_tick já foi escolhido
+    int term_rows, term_cols;   // Tamanho do terminal no último layout
+    int row_count;              // Linhas do simulador no último layout
+    bool cs_row;                // Linha de overhead mostrada
+    int rows;                   // Linhas de tarefas mostradas
+    int label_width;            // Largura de "T<id>"
+    int frame_lines;            // Altura do quadro
+    int start_tick;             // Primeiro tick da janela
+    char status[48];            // Texto após o tick atual (reprodução)
+    char* cells;                // Execuções de uma linha na janela
+    ScreenBuffer screen;        // Quadro no terminal e quadro em montagem
+} LiveView;
+
+static void live_view_init(LiveView* v) {
+    memset(v, 0, sizeof(LiveView));
+    const char* term = getenv("TERM");
+    v->enabled = isatty(STDIN_FILENO) && isatty(STDOUT_FILENO) &&
+                 term && strcmp(term, "dumb") != 0;
+    screen_init(&v->screen);
+}
+
+/**
+ * Estado da linha r do quadro: tarefa (r < rows) ou overhead (r == rows)
+ */
+static void live_row_state(Simulator* sim, const LiveView* v, int r, DebugRowInfo* info) {
+    if (r < v->rows) {
+        debug_row_info(sim, r, info);
+        return;
+    }
+    memset(info, 0, sizeof(DebugRowInfo));
+    info->color = DBG_MAGENTA;
+    snprintf(info->suffix, sizeof(info->suffix), "  " DBG_DIM "[%d trocas, %d ticks]" DBG_RESET,
+             sim->switch_count, sim->overhead_ticks);
+}
+
+/**
+ * Monta a linha r do quadro (rótulo, células da janela e texto à direita)
+ * na linha line da tela
+ */
+static void live_render_row(Simulator* sim, LiveView* v, int r, int line) {
+    ScreenBuffer* s = &v->screen;
+    int current = sim->clock.current_tick;
+    DebugRowInfo info;
+    live_row_state(sim, v, r, &info);
+
+    int col;
+    if (r < v->rows) {
+        col = screen_printf(s, line, 0, "%sT%-*d%s %s%c%s ", info.color, v->label_width - 1,
+                            row_id(sim, r), DBG_RESET, info.indicator_color, info.indicator,
+                            DBG_RESET);
+    } else {
+        col = screen_printf(s, line, 0, DBG_MAGENTA "%-*s" DBG_RESET "   ", v->label_width, "CS");
+    }
+
+    debug_paint_row(sim, (r < v->rows) ? r : sim->row_count, v->start_tick,
+                    v->start_tick + LIVE_WIDTH, v->cells);
+    for (int t = v->start_tick; t < v->start_tick + LIVE_WIDTH; t++) {
+        DebugGlyph glyph;
+        if (r < v->rows) {
+            glyph = debug_row_glyph(&info, t, current, v->cells[t - v->start_tick]);
+        } else {
+            glyph = (t < current && v->cells[t - v->start_tick]) ? GLYPH_OVERHEAD : GLYPH_IDLE;
         }
+        char text[32];
+        debug_glyph_text(text, info.color, glyph);
+        col = screen_puts(s, line, col, text);
+    }
+    screen_puts(s, line, col, info.suffix);
+}
+
+/**
+ * Monta o quadro inteiro do tick atual na tela
+ */
+static void live_render(Simulator* sim, LiveView* v) {
+    ScreenBuffer* s = &v->screen;
+    int current = sim->clock.current_tick;
+    int end = v->start_tick + LIVE_WIDTH;
+    int margin = v->label_width + 3;
+
+    screen_begin(s);
+    screen_puts(s, 0, 0, DBG_BOLD
+                "╔══════════════════════════════════════════════════════════════╗\n"
+                "║              GANTT CHART PROGRESSIVO                         ║\n"
+                "╚══════════════════════════════════════════════════════════════╝" DBG_RESET);
 
-        printf("\n");
+    // Escala de tempo
+    int col = margin;
+    for (int t = v->start_tick; t < end; t++) {
+        if (t % 5 == 0) col = screen_printf(s, LIVE_HEADER_LINES - 3, col, DBG_DIM "%-5d" DBG_RESET, t);
     }
 
-    // Linha divisória inferior
-    printf("      ");
-    for (int t = start_tick; t <= end_tick && t < start_tick + display_width; t++) {
-        printf("─");
+    // Marcador do tick atual
+    col = margin;
+    for (int t = v->start_tick; t < end; t++) {
+        const char* mark = (t == current) ? DBG_BOLD DBG_RED "▼" DBG_RESET
+                         : (t % 5 == 0) ? DBG_DIM "│" DBG_RESET : DBG_DIM "·" DBG_RESET;
+        col = screen_puts(s, LIVE_HEADER_LINES - 2, col, mark);
+    }
+    col = screen_printf(s, LIVE_HEADER_LINES - 2, col, "  " DBG_BOLD "◄ Tick %d" DBG_RESET, current);
+    screen_puts(s, LIVE_HEADER_LINES - 2, col, v->status);
+
+    // Linhas das tarefas e do overhead, entre divisórias
+    int line = LIVE_HEADER_LINES - 1;
+    for (int c = 0; c < LIVE_WIDTH; c++) screen_puts(s, line, margin + c, "─");
+    line++;
+
+    int last = v->rows + (v->cs_row ? 1 : 0);
+    for (int r = 0; r < last; r++) live_render_row(sim, v, r, line++);
+    if (v->rows < v->row_count) {
+        screen_printf(s, line++, margin, DBG_DIM "... mais %d linhas ('v' mostra o quadro completo)" DBG_RESET,
+                      v->row_count - v->rows);
     }
-    printf("\n");
+    for (int c = 0; c < LIVE_WIDTH; c++) screen_puts(s, line, margin + c, "─");
+    line++;
 
     // Legenda
-    printf("\n" DBG_BOLD "Legenda:" DBG_RESET " ");
-    printf("█=Executando  ");
-    printf(DBG_DIM "·" DBG_RESET "=Esperando  ");
-    printf(DBG_DIM "░" DBG_RESET "=Futuro  ");
-    printf(DBG_RED "▼" DBG_RESET "=Tick atual\n");
-
-    printf(DBG_BOLD "Estados:" DBG_RESET " ");
-    printf(DBG_DIM "N" DBG_RESET "=New  ");
-    printf(DBG_YELLOW "R" DBG_RESET "=Ready  ");
-    printf(DBG_GREEN "*" DBG_RESET "=Running  ");
-    printf(DBG_RED "B" DBG_RESET "=Blocked  ");
-    printf(DBG_DIM "D" DBG_RESET "=Done\n");
-
-    // Limpar memória
-    for (int i = 0; i < sim->task_count; i++) {
-        free(matrix[i]);
-        free(task_colors[i]);
+    screen_puts(s, line++, 0, DBG_BOLD "Legenda:" DBG_RESET " █=Executando  " DBG_DIM "·" DBG_RESET
+                "=Esperando  " DBG_DIM "░" DBG_RESET "=Futuro  " DBG_RED "▼" DBG_RESET "=Tick atual");
+    screen_puts(s, line, 0, DBG_BOLD "Estados:" DBG_RESET " " DBG_DIM "N" DBG_RESET "=New  " DBG_YELLOW "R"
+                DBG_RESET "=Ready  " DBG_GREEN "*" DBG_RESET "=Running  " DBG_RED "B" DBG_RESET
+                "=Blocked  " DBG_DIM "D" DBG_RESET "=Done");
+}
+
+/**
+ * Devolve a tela ao modo normal (sem região fixa); o próximo desenho refaz
+ * o layout
+ */
+static void live_view_release(LiveView* v) {
+    if (!v->on_screen) return;
+    screen_emit(&v->screen, "\033[r\033[%d;1H\n", v->term_rows);
+    fflush(stdout);
+    screen_flush(&v->screen, STDOUT_FILENO);
+    v->on_screen = false;
+}
+
+static void live_view_free(LiveView* v) {
+    if (!v->enabled) return;
+    live_view_release(v);
+    screen_free(&v->screen);
+    free(v->cells);
+}
+
+/**
+ * Prepara o layout para o tamanho atual do terminal: região de rolagem
+ * abaixo do quadro e tela com as linhas que cabem. Retorna false se o
+ * terminal for pequeno demais.
+ */
+static bool live_view_layout(Simulator* sim, LiveView* v, int term_rows, int term_cols) {
+    bool cs_row = (sim->switch_cost > 0 || sim->cache_penalty > 0);
+    int label_width = debug_label_width(sim);
+
+    int avail = term_rows - LIVE_HEADER_LINES - LIVE_FOOTER_LINES - (cs_row ? 1 : 0) -
+                LIVE_COMMAND_LINES;
+    int rows = (sim->row_count <= avail) ? sim->row_count : avail - 1;
+    if (rows < 1 || term_cols < label_width + 3 + LIVE_WIDTH + LIVE_SUFFIX_COLS) return false;
+
+    int frame_lines = LIVE_HEADER_LINES + rows + (cs_row ? 1 : 0) +
+                      (rows < sim->row_count ? 1 : 0) + LIVE_FOOTER_LINES;
+    if (!v->cells) v->cells = malloc(LIVE_WIDTH);
+    if (!v->cells || !screen_resize(&v->screen, frame_lines, term_cols)) return false;
+
+    v->term_rows = term_rows;
+    v->term_cols = term_cols;
+    v->row_count = sim->row_count;
+    v->cs_row = cs_row;
+    v->rows = rows;
+    v->label_width = label_width;
+    v->frame_lines = frame_lines;
+
+    // Limpar a tela (a tela em memória começa em branco) e deixar só as
+    // linhas abaixo do quadro rolando
+    screen_emit(&v->screen, "\033[r\033[H\033[2J\033[%d;%dr", frame_lines + 2, term_rows);
+    v->on_screen = true;
+    return true;
+}
+
+/**
+ * Mostra o tick atual no quadro fixo. Retorna false se não for possível
+ * (terminal pequeno ou tamanho desconhecido).
+ */
+static bool live_view_refresh(Simulator* sim, LiveView* v) {
+    struct winsize ws;
+    if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &ws) != 0 || ws.ws_row == 0) return false;
+
+    bool cs_row = (sim->switch_cost > 0 || sim->cache_penalty > 0);
+    bool relayout = !v->on_screen || ws.ws_row != v->term_rows || ws.ws_col != v->term_cols ||
+                    sim->row_count != v->row_count || cs_row != v->cs_row;
+    if (relayout && !live_view_layout(sim, v, ws.ws_row, ws.ws_col)) return false;
+
+    // Janela por páginas: só muda quando o tick atual sai dela
+    int current = sim->clock.current_tick;
+    if (!v->windowed || current < v->start_tick ||
+        current + LIVE_LOOKAHEAD >= v->start_tick + LIVE_WIDTH) {
+        v->start_tick = (current >= 10) ? (current - 10) / 10 * 10 : 0;
+        v->windowed = true;
     }
-    free(matrix);
-    free(task_colors);
+
+    if (!relayout) screen_emit(&v->screen, "\0337");    // Guardar o cursor do prompt
+    live_render(sim, v);
+    screen_present(&v->screen);
+    if (relayout) screen_emit(&v->screen, "\033[%d;1H", v->frame_lines + 2);
+    else screen_emit(&v->screen, "\0338");
+
+    // O que o programa já imprimiu vai antes do quadro
+    fflush(stdout);
+    screen_flush(&v->screen, STDOUT_FILENO);
+    return true;
+}
+
+/**
+ * Mostra o Gantt progressivo: atualiza o quadro fixo em terminal
+ * interativo, senão (ou se o terminal for pequeno) imprime o quadro comum.
+ */
+static void show_progress(Simulator* sim, LiveView* live) {
+    if (live->enabled && live_view_refresh(sim, live)) return;
+    if (live->enabled) live_view_release(live);
+    print_debug_gantt(sim);
 }
 
 /**
  * Imprime diagrama visual do estado das tarefas.
  */
 void print_task_diagram(Simulator* sim) {
-    printf("\n" DBG_BOLD "┌──────────────────────────────────────────────────────┐\n");
-    printf("│                    DIAGRAMA DE ESTADOS                 │\n");
-    printf("└──────────────────────────────────────────────────────────┘" DBG_RESET "\n\n");
+    TextWriter out;
+    if (!tw_attach(&out, stdout)) {
+        printf("Erro: Falha ao alocar memória\n");
+        return;
+    }
+
+    tw_puts(&out, "\n" DBG_BOLD "┌──────────────────────────────────────────────────────┐\n");
+    tw_puts(&out, "│                    DIAGRAMA DE ESTADOS                 │\n");
+    tw_puts(&out, "└──────────────────────────────────────────────────────────┘" DBG_RESET "\n\n");
+
+    char label[32];
 
     // Mostrar filas
-    printf(DBG_BOLD "  CPU:" DBG_RESET " ");
+    tw_puts(&out, DBG_BOLD "  CPU:" DBG_RESET " ");
     bool cpu_idle = true;
     for (int i = 0; i < sim->task_count; i++) {
         if (sim->tasks[i].state == STATE_RUNNING) {
-            const char* color = debug_get_color(sim->tasks[i].color);
-            printf("%s[T%d]%s ", color, i, DBG_RESET);
+            const char* color = row_ansi(sim, task_row(sim, &sim->tasks[i]));
+            task_label(sim, i, label, sizeof(label));
+            tw_printf(&out, "%s[%s]%s ", color, label, DBG_RESET);
             cpu_idle = false;
         }
     }
-    if (cpu_idle) printf(DBG_DIM "[idle]" DBG_RESET);
-    printf("\n\n");
+    if (cpu_idle) tw_puts(&out, DBG_DIM "[idle]" DBG_RESET);
+    tw_puts(&out, "\n\n");
 
-    printf(DBG_BOLD "  READY:" DBG_RESET " ");
+    tw_puts(&out, DBG_BOLD "  READY:" DBG_RESET " ");
     bool ready_empty = true;
     for (int i = 0; i < sim->task_count; i++) {
         if (sim->tasks[i].state == STATE_READY) {
-            const char* color = debug_get_color(sim->tasks[i].color);
-            printf("%s[T%d]%s ", color, i, DBG_RESET);
+            const char* color = row_ansi(sim, task_row(sim, &sim->tasks[i]));
+            task_label(sim, i, label, sizeof(label));
+            tw_printf(&out, "%s[%s]%s ", color, label, DBG_RESET);
             ready_empty = false;
         }
     }
-    if (ready_empty) printf(DBG_DIM "[vazia]" DBG_RESET);
-    printf("\n\n");
+    if (ready_empty) tw_puts(&out, DBG_DIM "[vazia]" DBG_RESET);
+    tw_puts(&out, "\n\n");
 
-    printf(DBG_BOLD "  WAITING:" DBG_RESET " ");
+    tw_puts(&out, DBG_BOLD "  WAITING:" DBG_RESET " ");
     bool waiting_empty = true;
-    for (int i = 0; i < sim->task_count; i++) {
+    for (int i = 0; i < sim->static_count; i++) {
         if (sim->tasks[i].state == STATE_NEW &&
             sim->tasks[i].arrival_time > sim->clock.current_tick) {
-            printf(DBG_DIM "[T%d:t=%d]" DBG_RESET " ", i, sim->tasks[i].arrival_time);
+            tw_printf(&out, DBG_DIM "[T%d:t=%d]" DBG_RESET " ",
+                      sim->tasks[i].id, sim->tasks[i].arrival_time);
             waiting_empty = false;
         }
     }
-    if (waiting_empty) printf(DBG_DIM "[vazia]" DBG_RESET);
-    printf("\n\n");
+    for (int p = 0; p < sim->periodic_count; p++) {
+        if (sim->periodic[p].next_release < sim->horizon) {
+            tw_printf(&out, DBG_DIM "[T%d:t=%d]" DBG_RESET " ",
+                      sim->periodic[p].id, sim->periodic[p].next_release);
+            waiting_empty = false;
+        }
+    }
+    if (waiting_empty) tw_puts(&out, DBG_DIM "[vazia]" DBG_RESET);
+    tw_puts(&out, "\n\n");
 
-    printf(DBG_BOLD "  DONE:" DBG_RESET " ");
+    tw_puts(&out, DBG_BOLD "  DONE:" DBG_RESET " ");
     bool done_empty = true;
-    for (int i = 0; i < sim->task_count; i++) {
+    for (int i = 0; i < sim->static_count; i++) {
         if (sim->tasks[i].state == STATE_TERMINATED) {
-            const char* color = debug_get_color(sim->tasks[i].color);
-            printf("%s[T%d]%s ", color, i, DBG_RESET);
+            const char* color = row_ansi(sim, task_row(sim, &sim->tasks[i]));
+            tw_printf(&out, "%s[T%d]%s ", color, sim->tasks[i].id, DBG_RESET);
             done_empty = false;
         }
     }
-    if (done_empty) printf(DBG_DIM "[vazia]" DBG_RESET);
-    printf("\n");
+    for (int p = 0; p < sim->periodic_count; p++) {
+        if (sim->periodic[p].jobs_completed > 0) {
+            const char* color = row_ansi(sim, sim->static_count + p);
+            tw_printf(&out, "%s[T%d x%d]%s ", color, sim->periodic[p].id,
+                      sim->periodic[p].jobs_completed, DBG_RESET);
+            done_empty = false;
+        }
+    }
+    if (done_empty) tw_puts(&out, DBG_DIM "[vazia]" DBG_RESET);
+    tw_puts(&out, "\n");
 
-    // Barra de progresso geral
-    int total_work = 0;
-    int done_work = 0;
+    // Barra de progresso geral (jobs periódicos contam pelo total previsto)
+    long long total_work = 0;
+    long long done_work = 0;
     for (int i = 0; i < sim->task_count; i++) {
-        total_work += sim->tasks[i].burst_time;
-        done_work += (sim->tasks[i].burst_time - sim->tasks[i].remaining_time);
+        TCB* t = &sim->tasks[i];
+        if (t->state == STATE_FREE) continue;
+        if (i < sim->static_count) total_work += t->burst_time;
+        done_work += (t->burst_time - t->remaining_time);
+    }
+    for (int p = 0; p < sim->periodic_count; p++) {
+        const PeriodicTask* pt = &sim->periodic[p];
+        long long jobs = pt->jobs_released;
+        if (pt->next_release < sim->horizon) {
+            jobs += (sim->horizon - pt->next_release + pt->period - 1) / pt->period;
+        }
+        total_work += jobs * pt->wcet;
+        done_work += (long long)pt->jobs_completed * pt->wcet;
     }
 
-    int progress = (total_work > 0) ? (done_work * 30 / total_work) : 0;
+    int progress = (total_work > 0) ? (int)(done_work * 30 / total_work) : 0;
 
-    printf("\n" DBG_BOLD "  Progresso:" DBG_RESET " [");
+    tw_puts(&out, "\n" DBG_BOLD "  Progresso:" DBG_RESET " [");
     for (int i = 0; i < 30; i++) {
         if (i < progress) {
-            printf(DBG_GREEN "█" DBG_RESET);
+            tw_puts(&out, DBG_GREEN "█" DBG_RESET);
         } else {
-            printf(DBG_DIM "░" DBG_RESET);
+            tw_puts(&out, DBG_DIM "░" DBG_RESET);
         }
     }
-    printf("] %d%%\n", (total_work > 0) ? (done_work * 100 / total_work) : 0);
+    tw_printf(&out, "] %d%%\n", (total_work > 0) ? (int)(done_work * 100 / total_work) : 0);
+    tw_close(&out);
 }
 
 /**
  * Imprime o estado atual do sistema (para modo debug).
  */
 void print_system_state(Simulator* sim) {
-    printf("\n┌─────────────────────────────────────────────────────────┐\n");
-    printf("│ ESTADO DO SISTEMA - Tick: %-4d                          │\n",
-           sim->clock.current_tick);
-    printf("├─────────────────────────────────────────────────────────┤\n");
-    printf("│ ID │ Estado     │ Chegada │ Burst │ Restante │ Prior. │\n");
-    printf("├────┼────────────┼─────────┼───────┼──────────┼────────┤\n");
+    TextWriter out;
+    if (!tw_attach(&out, stdout)) {
+        printf("Erro: Falha ao alocar memória\n");
+        return;
+    }
+
+    tw_puts(&out, "\n┌──────────────────────────────────────────────────────────────────────┐\n");
+    tw_printf(&out, "│ ESTADO DO SISTEMA - Tick: %-4d                                       │\n",
+              sim->clock.current_tick);
+    tw_puts(&out, "├──────────────────────────────────────────────────────────────────────┤\n");
+    tw_puts(&out, "│ ID     │ Estado     │ Chegada │ Burst │ Restante │ Prior. │ Prazo  │\n");
+    tw_puts(&out, "├────────┼────────────┼─────────┼───────┼──────────┼────────┼────────┤\n");
 
     for (int i = 0; i < sim->task_count; i++) {
         TCB* t = &sim->tasks[i];
+        if (t->state == STATE_FREE) continue;
+
+        // Jobs periódicos aparecem como <id>.<job>
+        char id_str[16];
+        if (t->periodic_idx >= 0) {
+            snprintf(id_str, sizeof(id_str), "%d.%d", t->id, t->job_seq);
+        } else {
+            snprintf(id_str, sizeof(id_str), "%d", t->id);
+        }
+
         const char* state_str;
         switch (t->state) {
             case STATE_NEW:        state_str = "NEW       "; break;
@@ -1124,24 +2896,393 @@ void print_system_state(Simulator* sim) {
             case STATE_TERMINATED: state_str = "TERMINATED"; break;
             default:               state_str = "???       ";
         }
-        printf("│ %2d │ %s │ %7d │ %5d │ %8d │ %6d │\n",
-               t->id, state_str, t->arrival_time, t->burst_time,
-               t->remaining_time, t->priority);
+        // Prazo: '!' indica prazo já ultrapassado sem término
+        char deadline_str[16] = "-";
+        if (t->abs_deadline >= 0) {
+            bool late = t->deadline_missed ||
+                        (t->state != STATE_TERMINATED &&
+                         sim->clock.current_tick > t->abs_deadline);
+            snprintf(deadline_str, sizeof(deadline_str), "%d%s",
+                     t->abs_deadline, late ? "!" : "");
+        }
+        tw_printf(&out, "│ %-6s │ %s │ %7d │ %5d │ %8d │ %6d │ %6s │\n",
+                  id_str, state_str, t->arrival_time, t->burst_time,
+                  t->remaining_time, t->priority, deadline_str);
+    }
+    tw_puts(&out, "└──────────────────────────────────────────────────────────────────────┘\n");
+    tw_close(&out);
+}
+
+// =============================================================================
+// PARADAS CONDICIONAIS (MODO DEBUG)
+// =============================================================================
+
+#define MAX_BREAKPOINTS     16  // Paradas definidas ao mesmo tempo
+
+// Condição de uma parada
+typedef enum {
+    BREAK_TICK,                 // O relógio chega ao tick
+    BREAK_PREEMPT,              // A tarefa perde a CPU ainda com trabalho
+    BREAK_DONE,                 // A tarefa (ou um job dela) termina
+    BREAK_READY,                // Fila de prontos passa de arg tarefas
+    BREAK_WAIT                  // Alguma tarefa passa de arg ticks de espera
+} BreakKind;
+
+typedef struct {
+    BreakKind kind;
+    int arg;                    // Tick, id da tarefa ou limite
+    int row;                    // Tarefa: linha do Gantt do id
+    int before;                 // Término: jobs concluídos antes do tick
+    bool holds;                 // Fila/espera: condição valia no último tick
+} Breakpoint;
+
+/**
+ * Paradas do modo debug. São verificadas depois de cada tick avançado no
+ * debugger (Enter, n, g, p, c), comparando o estado com o do início do
+ * tick; simulate_tick não muda. As condições de fila e espera disparam só
+ * quando passam a valer, para que continuar não pare de novo no tick
+ * seguinte.
+ */
+typedef struct {
+    Breakpoint items[MAX_BREAKPOINTS];
+    int count;
+    int running;                // Slot em execução no início do tick (-1 = nenhum)
+} BreakpointSet;
+
+static const char* const break_names[] = { "tick", "preempt", "done", "ready", "wait" };
+
+/**
+ * Jobs concluídos da linha row: 0/1 para tarefas comuns, contagem de jobs
+ * para periódicas
+ */
+static int break_done_count(Simulator* sim, int row) {
+    if (row < sim->static_count) return sim->tasks[row].state == STATE_TERMINATED;
+    return sim->periodic[row - sim->static_count].jobs_completed;
+}
+
+/**
+ * Condições de nível (fila de prontos e espera), no estado atual
+ */
+static bool break_level_holds(Simulator* sim, const Breakpoint* bp) {
+    int ready = 0;
+    for (int i = 0; i < sim->task_count; i++) {
+        TCB* t = &sim->tasks[i];
+        if (t->state != STATE_READY && t->state != STATE_RUNNING) continue;
+        if (t->state == STATE_READY) ready++;
+
+        // Espera até agora: tempo no sistema menos tempo de CPU
+        int waited = sim->clock.current_tick - t->arrival_time - (t->burst_time - t->remaining_time);
+        if (bp->kind == BREAK_WAIT && waited > bp->arg) return true;
+    }
+    return bp->kind == BREAK_READY && ready > bp->arg;
+}
+
+/**
+ * Reavalia as condições de nível (depois de definir uma parada ou voltar
+ * no tempo)
+ */
+static void breakpoints_sync(Simulator* sim, BreakpointSet* set) {
+    for (int b = 0; b < set->count; b++) {
+        Breakpoint* bp = &set->items[b];
+        if (bp->kind == BREAK_READY || bp->kind == BREAK_WAIT) bp->holds = break_level_holds(sim, bp);
+    }
+}
+
+/**
+ * Interpreta "<condição> <número>" e acrescenta a parada. Retorna false
+ * (com mensagem) se for inválida.
+ */
+static bool breakpoint_add(Simulator* sim, BreakpointSet* set, const char* text) {
+    char name[16];
+    int arg;
+    if (sscanf(text, "%15s %d", name, &arg) != 2) {
+        printf("Condição inválida. Use: tick T, preempt X, done X, ready K ou wait W\n");
+        return false;
+    }
+
+    int kind = -1;
+    for (int k = 0; k < (int)(sizeof(break_names) / sizeof(break_names[0])); k++) {
+        if (strcmp(name, break_names[k]) == 0) kind = k;
+    }
+    if (kind < 0) {
+        printf("Condição desconhecida '%s'. Use: tick, preempt, done, ready ou wait\n", name);
+        return false;
+    }
+    int row = task_map_get(&sim->id_rows, arg);
+    if ((kind == BREAK_PREEMPT || kind == BREAK_DONE) && row < 0) {
+        printf("Tarefa T%d não existe.\n", arg);
+        return false;
+    }
+    if (arg < 0) {
+        printf("O valor deve ser positivo.\n");
+        return false;
+    }
+    if (set->count == MAX_BREAKPOINTS) {
+        printf("Limite de %d paradas atingido.\n", MAX_BREAKPOINTS);
+        return false;
+    }
+
+    Breakpoint* bp = &set->items[set->count++];
+    bp->kind = (BreakKind)kind;
+    bp->arg = arg;
+    bp->row = row;
+    bp->holds = false;
+    breakpoints_sync(sim, set);
+    printf("Parada %d: %s %d\n", set->count, break_names[kind], arg);
+    return true;
+}
+
+static void breakpoints_list(const BreakpointSet* set) {
+    if (set->count == 0) {
+        printf("Nenhuma parada definida.\n");
+        return;
+    }
+    printf("Paradas:\n");
+    for (int b = 0; b < set->count; b++) {
+        printf("  %d. %s %d\n", b + 1, break_names[set->items[b].kind], set->items[b].arg);
+    }
+}
+
+/**
+ * Avança um tick e verifica as paradas. Retorna as paradas que dispararam
+ * (bit b = items[b]), 0 se nenhuma.
+ */
+static int debug_tick(Simulator* sim, BreakpointSet* set) {
+    if (set->count == 0) {
+        simulate_tick(sim);
+        return 0;
+    }
+
+    // Estado do início do tick usado pelas condições de transição
+    set->running = sim->current_task ? (int)(sim->current_task - sim->tasks) : -1;
+    for (int b = 0; b < set->count; b++) {
+        Breakpoint* bp = &set->items[b];
+        if (bp->kind == BREAK_DONE) bp->before = break_done_count(sim, bp->row);
+    }
+
+    simulate_tick(sim);
+
+    int hits = 0;
+    for (int b = 0; b < set->count; b++) {
+        Breakpoint* bp = &set->items[b];
+        bool fired = false;
+        switch (bp->kind) {
+            case BREAK_TICK:
+                fired = (sim->clock.current_tick == bp->arg);
+                break;
+            case BREAK_PREEMPT: {
+                // Slot lido pelo índice: o vetor de tarefas pode ter crescido
+                TCB* prev = (set->running >= 0) ? &sim->tasks[set->running] : NULL;
+                fired = prev && task_row(sim, prev) == bp->row && prev->state == STATE_READY &&
+                        sim->current_task != prev;
+                break;
+            }
+            case BREAK_DONE:
+                fired = (break_done_count(sim, bp->row) > bp->before);
+                break;
+            case BREAK_READY:
+            case BREAK_WAIT: {
+                bool holds = break_level_holds(sim, bp);
+                fired = holds && !bp->holds;
+                bp->holds = holds;
+                break;
+            }
+        }
+        if (fired) hits |= 1 << b;
+    }
+    return hits;
+}
+
+/**
+ * Avança até o tick target, o fim da simulação ou uma parada. Retorna
+ * true (e avisa) se uma parada disparou.
+ */
+static bool debug_run(Simulator* sim, BreakpointSet* set, int target) {
+    while (sim->clock.current_tick < target && !all_tasks_completed(sim)) {
+        int hits = debug_tick(sim, set);
+        if (hits != 0) {
+            printf(DBG_RED "● Tick %d:", sim->clock.current_tick);
+            for (int b = 0; b < set->count; b++) {
+                if (hits & (1 << b)) {
+                    printf(" parada %d (%s %d)", b + 1, break_names[set->items[b].kind], set->items[b].arg);
+                }
+            }
+            printf(DBG_RESET "\n");
+            return true;
+        }
+    }
+    return false;
+}
+
+// =============================================================================
+// REPRODUÇÃO AUTOMÁTICA (MODO DEBUG)
+// =============================================================================
+
+#define PLAY_MAX_FPS        30  // Quadros por segundo no máximo
+
+static double monotonic_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/**
+ * Espera até timeout segundos (< 0 = sem limite) por uma tecla. Retorna a
+ * tecla, -1 se o tempo acabou ou -2 se a entrada foi encerrada.
+ */
+static int play_wait_key(bool keys, double timeout) {
+    if (!keys) {
+        if (timeout > 0) {
+            struct timespec ts = { (time_t)timeout, (long)((timeout - (time_t)timeout) * 1e9) };
+            nanosleep(&ts, NULL);
+        }
+        return -1;
+    }
+
+    fd_set fds;
+    FD_ZERO(&fds);
+    FD_SET(STDIN_FILENO, &fds);
+    struct timeval tv;
+    if (timeout >= 0) {
+        tv.tv_sec = (long)timeout;
+        tv.tv_usec = (long)((timeout - (long)timeout) * 1e6);
+    }
+    if (select(STDIN_FILENO + 1, &fds, NULL, NULL, (timeout >= 0) ? &tv : NULL) <= 0) return -1;
+
+    unsigned char c;
+    return (read(STDIN_FILENO, &c, 1) == 1) ? c : -2;
+}
+
+static void play_status(LiveView* live, bool paused, int rate) {
+    if (paused) {
+        snprintf(live->status, sizeof(live->status), "  " DBG_YELLOW "❚❚ pausa" DBG_RESET);
+    } else {
+        snprintf(live->status, sizeof(live->status), "  " DBG_GREEN "▶ %d ticks/s" DBG_RESET, rate);
+    }
+}
+
+/**
+ * Reproduz a simulação a *rate ticks por segundo até o fim ou até o
+ * usuário parar. Com a entrada em um terminal, as teclas são lidas sem
+ * bloquear (modo não-canônico): espaço pausa/continua, '+'/'-' dobram ou
+ * dividem a velocidade, '.' avança um tick na pausa e Enter/q param.
+ *
+ * A simulação segue o relógio, não o desenho: a cada volta são simulados
+ * os ticks já devidos e só então o quadro é desenhado (no máximo
+ * PLAY_MAX_FPS por segundo). Se o terminal não acompanha, os quadros
+ * intermediários são descartados e o ritmo da simulação se mantém. Uma
+ * parada que dispara encerra a reprodução.
+ */
+static void run_playback(Simulator* sim, LiveView* live, BreakpointSet* breaks, bool show_graph,
+                         int* rate) {
+    bool keys = isatty(STDIN_FILENO);
+    struct termios saved;
+    if (keys && tcgetattr(STDIN_FILENO, &saved) == 0) {
+        struct termios raw = saved;
+        raw.c_lflag &= ~(ICANON | ECHO | ISIG);     // Ctrl-C também só para a reprodução
+        raw.c_cc[VMIN] = 1;
+        raw.c_cc[VTIME] = 0;
+        tcsetattr(STDIN_FILENO, TCSANOW, &raw);
+    } else {
+        keys = false;
+    }
+
+    printf(DBG_GREEN "▶ Reproduzindo a %d ticks/s" DBG_RESET "%s\n", *rate,
+           keys ? "  (espaço=pausa, +/-=velocidade, .=um tick, Enter/q=parar)" : "");
+
+    int start_tick = sim->clock.current_tick;
+    int frames = 0;
+    bool paused = false;
+    bool dirty = true;
+    bool hit = false;
+    double origin = monotonic_seconds();    // Ticks devidos contam a partir daqui
+    long long done = 0;                     // Ticks simulados desde origin
+    double last_frame = -1.0;
+    double frame_interval = 1.0 / PLAY_MAX_FPS;
+    play_status(live, paused, *rate);
+
+    while (!all_tasks_completed(sim)) {
+        double now = monotonic_seconds();
+
+        // Simular os ticks devidos, sem passar de um intervalo de quadro
+        if (!paused) {
+            long long due = (long long)((now - origin) * *rate);
+            while (done < due && !all_tasks_completed(sim)) {
+                hit = debug_run(sim, breaks, sim->clock.current_tick + 1);
+                done++;
+                dirty = true;
+                if (hit) break;
+                if ((done & 255) == 0 && monotonic_seconds() - now > frame_interval) {
+                    // A simulação não acompanha o ritmo: seguir do ponto atual
+                    origin = monotonic_seconds() - (double)done / *rate;
+                    break;
+                }
+            }
+            if (hit || all_tasks_completed(sim)) break;
+        }
+
+        now = monotonic_seconds();
+        if (dirty && show_graph && now - last_frame >= frame_interval) {
+            show_progress(sim, live);
+            frames++;
+            dirty = false;
+            last_frame = now;
+        }
+
+        // Dormir até o próximo tick, o próximo quadro ou uma tecla
+        double timeout = -1.0;
+        if (!paused) {
+            timeout = origin + (double)(done + 1) / *rate - now;
+            if (dirty && show_graph && last_frame + frame_interval - now < timeout) {
+                timeout = last_frame + frame_interval - now;
+            }
+            if (timeout < 0) timeout = 0;
+        }
+
+        int key = play_wait_key(keys, timeout);
+        if (key == -1) continue;
+        if (key == -2 || key == '\n' || key == '\r' || key == 'q' || key == 'Q' || key == 3) break;
+
+        if (key == ' ' || key == '+' || key == '-') {
+            if (key == ' ') paused = !paused;
+            else if (key == '+' && *rate < 1000000) *rate *= 2;
+            else if (key == '-' && *rate > 1) *rate /= 2;
+            origin = monotonic_seconds();   // Novo ritmo vale daqui em diante
+            done = 0;
+        } else if (key == '.' && paused) {
+            if (debug_run(sim, breaks, sim->clock.current_tick + 1)) break;
+        } else {
+            continue;
+        }
+        play_status(live, paused, *rate);
+        dirty = true;
+        last_frame = -1.0;                  // Mostrar a mudança já
+    }
+
+    live->status[0] = '\0';
+    if (show_graph) {
+        show_progress(sim, live);
+        frames++;
     }
-    printf("└─────────────────────────────────────────────────────────┘\n");
+    if (keys) tcsetattr(STDIN_FILENO, TCSANOW, &saved);
+
+    printf(DBG_YELLOW "■ Reprodução parada no tick %d" DBG_RESET " (%d ticks, %d quadros)\n",
+           sim->clock.current_tick, sim->clock.current_tick - start_tick, frames);
 }
 
 /**
  * Execução passo-a-passo com depuração (req. 1.5.1 e 1.5.2).
  * Agora inclui visualização gráfica progressiva.
  */
-void run_step_by_step(Simulator* sim) {
+void run_step_by_step(Simulator* sim, int play_rate) {
     printf("\n╔══════════════════════════════════════════════════════════════╗\n");
     printf("║              MODO DEBUG - PASSO A PASSO                      ║\n");
     printf("╠══════════════════════════════════════════════════════════════╣\n");
     printf("║ Comandos:                                                    ║\n");
     printf("║   [Enter] - Avançar um tick (com gráfico)                    ║\n");
     printf("║   [n]     - Avançar N ticks                                  ║\n");
+    printf("║   [p]     - Reproduzir (animação a N ticks/s)                ║\n");
+    printf("║   [w]     - Definir parada condicional (x = remover)         ║\n");
     printf("║   [b]     - Retroceder um tick                               ║\n");
     printf("║   [g]     - Ir para tick específico                          ║\n");
     printf("║   [v]     - Ver gráfico de Gantt progressivo                 ║\n");
@@ -1155,9 +3296,13 @@ void run_step_by_step(Simulator* sim) {
     char cmd[20];
     sim->verbose = false;  // Desativar log verboso, usaremos gráfico
     bool show_graph = true; // Mostrar gráfico automaticamente
+    LiveView live;          // Quadro fixo em terminal interativo
+    live_view_init(&live);
+    BreakpointSet breaks;   // Paradas condicionais
+    breaks.count = 0;
 
     // Mostrar estado inicial
-    print_debug_gantt(sim);
+    show_progress(sim, &live);
     print_task_diagram(sim);
 
     while (!all_tasks_completed(sim)) {
@@ -1174,15 +3319,18 @@ void run_step_by_step(Simulator* sim) {
 
         if (strlen(cmd) == 0 || cmd[0] == '\n') {
             // Enter - avançar um tick e mostrar gráfico
-            simulate_tick(sim);
+            debug_run(sim, &breaks, sim->clock.current_tick + 1);
             if (show_graph) {
-                print_debug_gantt(sim);
+                show_progress(sim, &live);
             }
         }
         else if (cmd[0] == '?') {
             printf("\nComandos disponíveis:\n");
             printf("  Enter - Avançar um tick\n");
             printf("  n     - Avançar N ticks\n");
+            printf("  p     - Reproduzir automaticamente (espaço=pausa, +/-=velocidade)\n");
+            printf("  w     - Parada: tick T, preempt X, done X, ready K, wait W (Enter = listar)\n");
+            printf("  x     - Remover parada (Enter = todas)\n");
             printf("  b     - Retroceder um tick\n");
             printf("  g     - Ir para tick específico\n");
             printf("  v     - Ver gráfico de Gantt\n");
@@ -1199,6 +3347,7 @@ void run_step_by_step(Simulator* sim) {
         }
         else if (cmd[0] == 't' || cmd[0] == 'T') {
             show_graph = !show_graph;
+            if (!show_graph) live_view_release(&live);
             printf("Gráfico automático: %s\n", show_graph ? "ATIVADO" : "DESATIVADO");
         }
         else if (cmd[0] == 'v' || cmd[0] == 'V') {
@@ -1213,10 +3362,23 @@ void run_step_by_step(Simulator* sim) {
             print_system_state(sim);
         }
         else if (cmd[0] == 'c' || cmd[0] == 'C') {
-            printf("Continuando execução...\n");
-            sim->verbose = true;
-            while (!all_tasks_completed(sim)) {
-                simulate_tick(sim);
+            if (breaks.count > 0) {
+                // Com paradas: velocidade máxima, sem log nem gráfico
+                printf("Continuando até uma parada...\n");
+                if (debug_run(sim, &breaks, INT_MAX)) {
+                    if (show_graph) {
+                        show_progress(sim, &live);
+                    }
+                    continue;
+                }
+                live_view_release(&live);
+            } else {
+                live_view_release(&live);
+                printf("Continuando execução...\n");
+                sim->verbose = true;
+                while (!all_tasks_completed(sim)) {
+                    simulate_tick(sim);
+                }
             }
             // Mostrar gráfico final
             print_debug_gantt(sim);
@@ -1230,9 +3392,10 @@ void run_step_by_step(Simulator* sim) {
             int target = sim->clock.current_tick - 1;
             if (target >= 0) {
                 restore_snapshot(sim, target);
+                breakpoints_sync(sim, &breaks);
                 printf(DBG_YELLOW "← Retrocedido para tick %d" DBG_RESET "\n", target);
                 if (show_graph) {
-                    print_debug_gantt(sim);
+                    show_progress(sim, &live);
                 }
             } else {
                 printf("Já está no início da simulação.\n");
@@ -1247,30 +3410,64 @@ void run_step_by_step(Simulator* sim) {
 
                 if (target < sim->clock.current_tick) {
                     restore_snapshot(sim, target);
+                    breakpoints_sync(sim, &breaks);
                     printf(DBG_YELLOW "← Retrocedido para tick %d" DBG_RESET "\n", target);
                 } else if (target > sim->clock.current_tick) {
                     printf("Avançando para tick %d...\n", target);
-                    while (sim->clock.current_tick < target && !all_tasks_completed(sim)) {
-                        simulate_tick(sim);
+                    if (!debug_run(sim, &breaks, target)) {
+                        printf(DBG_GREEN "→ Avançado para tick %d" DBG_RESET "\n", sim->clock.current_tick);
                     }
-                    printf(DBG_GREEN "→ Avançado para tick %d" DBG_RESET "\n", sim->clock.current_tick);
                 }
                 if (show_graph) {
-                    print_debug_gantt(sim);
+                    show_progress(sim, &live);
                 }
             }
         }
+        else if (cmd[0] == 'p' || cmd[0] == 'P') {
+            printf("Ticks por segundo (Enter = %d)? ", play_rate);
+            char line[32];
+            if (fgets(line, sizeof(line), stdin) != NULL) {
+                int rate;
+                if (sscanf(line, "%d", &rate) == 1 && rate > 0) play_rate = rate;
+                run_playback(sim, &live, &breaks, show_graph, &play_rate);
+            }
+        }
+        else if (cmd[0] == 'w' || cmd[0] == 'W') {
+            printf("Parada (tick T, preempt X, done X, ready K, wait W; Enter = listar): ");
+            char line[64];
+            if (fgets(line, sizeof(line), stdin) != NULL) {
+                if (line[strspn(line, " \t\r\n")] == '\0') breakpoints_list(&breaks);
+                else breakpoint_add(sim, &breaks, line);
+            }
+        }
+        else if (cmd[0] == 'x' || cmd[0] == 'X') {
+            printf("Remover qual parada (Enter = todas)? ");
+            char line[32];
+            int b;
+            if (fgets(line, sizeof(line), stdin) == NULL) {
+                // Entrada encerrada: o laço principal trata
+            } else if (sscanf(line, "%d", &b) != 1) {
+                breaks.count = 0;
+                printf("Paradas removidas.\n");
+            } else if (b >= 1 && b <= breaks.count) {
+                memmove(&breaks.items[b - 1], &breaks.items[b],
+                        (breaks.count - b) * sizeof(Breakpoint));
+                breaks.count--;
+                printf("Parada %d removida.\n", b);
+            } else {
+                printf("Parada %d não existe.\n", b);
+            }
+        }
         else if (cmd[0] == 'n' || cmd[0] == 'N') {
             printf("Quantos ticks? ");
             int n;
             if (scanf("%d", &n) == 1) {
                 getchar(); // Consumir newline
                 printf("Avançando %d ticks...\n", n);
-                for (int j = 0; j < n && !all_tasks_completed(sim); j++) {
-                    simulate_tick(sim);
-                }
+                int current = sim->clock.current_tick;
+                debug_run(sim, &breaks, (n <= 0) ? current : (n > INT_MAX - current) ? INT_MAX : current + n);
                 if (show_graph) {
-                    print_debug_gantt(sim);
+                    show_progress(sim, &live);
                 }
             }
         }
@@ -1279,6 +3476,7 @@ void run_step_by_step(Simulator* sim) {
         }
     }
 
+    live_view_free(&live);
     if (all_tasks_completed(sim)) {
         printf("\n" DBG_GREEN "✓ Todas as tarefas concluídas!" DBG_RESET "\n");
         print_debug_gantt(sim);
@@ -1290,6 +3488,128 @@ void run_step_by_step(Simulator* sim) {
 // ESTATÍSTICAS E SAÍDA
 // =============================================================================
 
+/**
+ * Imprime o custo das trocas de contexto (usado com as estatísticas
+ * detalhadas, cuja tabela não conhece o simulador).
+ */
+void print_switch_statistics(Simulator* sim) {
+    int total = sim->clock.current_tick;
+    double lost = (total > 0) ? 100.0 * sim->overhead_ticks / total : 0.0;
+
+    printf("\nTROCAS DE CONTEXTO:\n");
+    printf("───────────────────\n");
+    printf("• Trocas realizadas: %d (custo %d, cache frio %d ticks)\n",
+           sim->switch_count, sim->switch_cost, sim->cache_penalty);
+    printf("• Tempo de CPU perdido com overhead: %d ticks (%.1f%%)\n",
+           sim->overhead_ticks, lost);
+}
+
+/**
+ * Imprime uma linha da tabela de fatia proporcional.
+ */
+static void print_share_row(int id, int tickets, long long cpu, double entitled,
+                            long long busy) {
+    double achieved_pct = (busy > 0) ? 100.0 * cpu / busy : 0.0;
+    double entitled_pct = (busy > 0) ? 100.0 * entitled / busy : 0.0;
+    double ratio = (entitled > 0.0) ? cpu / entitled : 0.0;
+    printf("║ %2d ║ %8d ║ %9lld ║ %9.1f ║ %7.1f%% ║ %8.1f%% ║ %6.2f ║\n",
+           id, tickets, cpu, entitled, achieved_pct, entitled_pct, ratio);
+}
+
+/**
+ * Imprime a fatia de CPU obtida por tarefa contra a fatia a que ela tinha
+ * direito pelos bilhetes (apenas LOTTERY/STRIDE). Jobs periódicos são
+ * agregados na linha da sua tarefa.
+ */
+void print_share_statistics(Simulator* sim) {
+    if (!is_proportional(sim->policy)) return;
+
+    // CPU total usada (comuns + jobs vivos + jobs concluídos)
+    long long busy = 0;
+    for (int i = 0; i < sim->task_count; i++) {
+        TCB* t = &sim->tasks[i];
+        if (t->state == STATE_FREE) continue;
+        busy += t->burst_time - t->remaining_time;
+    }
+    for (int p = 0; p < sim->periodic_count; p++) {
+        busy += (long long)sim->periodic[p].jobs_completed * sim->periodic[p].wcet;
+    }
+
+    printf("\n╔════════════════════════════════════════════════════════════════════════╗\n");
+    printf("║          FATIA PROPORCIONAL - %-8s (obtido vs. direito)            ║\n",
+           sim->algorithm);
+    printf("╠════╦══════════╦═══════════╦═══════════╦══════════╦═══════════╦════════╣\n");
+    printf("║ ID ║ Bilhetes ║ CPU ticks ║  Direito  ║  Obtido  ║  Direito  ║ Razão  ║\n");
+    printf("╠════╬══════════╬═══════════╬═══════════╬══════════╬═══════════╬════════╣\n");
+
+    for (int i = 0; i < sim->static_count; i++) {
+        TCB* t = &sim->tasks[i];
+        print_share_row(t->id, t->tickets, t->burst_time - t->remaining_time,
+                        task_entitled(sim, t), busy);
+    }
+    for (int p = 0; p < sim->periodic_count; p++) {
+        const PeriodicTask* pt = &sim->periodic[p];
+        long long cpu = (long long)pt->jobs_completed * pt->wcet;
+        double entitled = pt->total_entitled;
+
+        // Jobs ainda vivos contam com o que já executaram
+        for (int i = sim->static_count; i < sim->task_count; i++) {
+            TCB* job = &sim->tasks[i];
+            if (job->periodic_idx == p && job->state != STATE_FREE) {
+                cpu += job->burst_time - job->remaining_time;
+                entitled += task_entitled(sim, job);
+            }
+        }
+        print_share_row(pt->id, pt->tickets, cpu, entitled, busy);
+    }
+    printf("╚════╩══════════╩═══════════╩═══════════╩══════════╩═══════════╩════════╝\n");
+    printf("  Razão = CPU obtida / direito (1.00 = exatamente proporcional)\n");
+}
+
+/**
+ * Imprime as estatísticas agregadas por tarefa periódica.
+ * Não imprime nada se não houver tarefas periódicas.
+ */
+void print_periodic_statistics(Simulator* sim) {
+    if (sim->periodic_count == 0) return;
+
+    printf("\n╔═══════════════════════════════════════════════════════════════════════════════╗\n");
+    printf("║              TAREFAS PERIÓDICAS (horizonte = %-6d)                          ║\n",
+           sim->horizon);
+    printf("╠════╦═════════╦══════╦═══════╦═══════╦════════════╦══════════╦════════╦════════╣\n");
+    printf("║ ID ║ Período ║ WCET ║ Jobs  ║ Concl ║ Resp.Média ║ Resp.Máx ║ Perdas ║ Atraso ║\n");
+    printf("╠════╬═════════╬══════╬═══════╬═══════╬════════════╬══════════╬════════╬════════╣\n");
+
+    for (int p = 0; p < sim->periodic_count; p++) {
+        const PeriodicTask* pt = &sim->periodic[p];
+        double avg_resp = (pt->jobs_completed > 0)
+            ? (double)pt->total_response / pt->jobs_completed : 0.0;
+        printf("║ %2d ║ %7d ║ %4d ║ %5d ║ %5d ║ %10.2f ║ %8d ║ %6d ║ %6d ║\n",
+               pt->id, pt->period, pt->wcet, pt->jobs_released, pt->jobs_completed,
+               avg_resp, pt->max_response, pt->deadline_misses, pt->max_lateness);
+    }
+    printf("╚════╩═════════╩══════╩═══════╩═══════╩════════════╩══════════╩════════╩════════╝\n");
+}
+
+/**
+ * Imprime só o resumo das métricas (--summary): percentis acumulados no
+ * término de cada tarefa e de cada job periódico, sem tabela por tarefa
+ * nem cópia das TCBs.
+ */
+void print_statistics_summary(Simulator* sim) {
+    TaskSummary* all = malloc(sizeof(TaskSummary));
+    *all = sim->summary;
+    task_summary_merge(all, &sim->job_summary);
+    show_summary(all, sim->job_summary.turnaround.count, sim->algorithm,
+                 sim->clock.current_tick);
+    free(all);
+    if (sim->miss_count > 0) {
+        printf("• Prazos perdidos: %d\n", sim->miss_count);
+    }
+    print_switch_statistics(sim);
+    print_periodic_statistics(sim);
+}
+
 /**
  * Imprime estatísticas simples no console.
  */
@@ -1304,7 +3624,7 @@ void print_statistics_simple(Simulator* sim) {
     float avg_waiting = 0;
     float avg_response = 0;
 
-    for (int i = 0; i < sim->task_count; i++) {
+    for (int i = 0; i < sim->static_count; i++) {
         TCB* t = &sim->tasks[i];
         printf("║ %2d ║ %7d ║ %5d ║ %8d ║ %10d ║ %13d ║\n",
                t->id, t->arrival_time, t->burst_time,
@@ -1315,16 +3635,84 @@ void print_statistics_simple(Simulator* sim) {
         avg_response += t->response_time;
     }
 
-    avg_turnaround /= sim->task_count;
-    avg_waiting /= sim->task_count;
-    avg_response /= sim->task_count;
+    if (sim->static_count > 0) {
+        avg_turnaround /= sim->static_count;
+        avg_waiting /= sim->static_count;
+        avg_response /= sim->static_count;
+    }
+
+    // Throughput conta tarefas comuns e jobs periódicos concluídos
+    int finished = sim->static_count;
+    for (int p = 0; p < sim->periodic_count; p++) {
+        finished += sim->periodic[p].jobs_completed;
+    }
+    float throughput = (sim->clock.current_tick > 0)
+        ? (float)finished / sim->clock.current_tick : 0.0f;
 
     printf("╠════╩═════════╩═══════╩══════════╩════════════╩═══════════════╣\n");
     printf("║ Médias:  Turnaround = %6.2f  |  Waiting = %6.2f           ║\n",
            avg_turnaround, avg_waiting);
     printf("║          Response = %6.2f    |  Throughput = %5.3f tasks/tick ║\n",
-           avg_response, (float)sim->task_count / sim->clock.current_tick);
+           avg_response, throughput);
+    printf("║ Trocas:  Contexto = %4d      |  Overhead = %5d ticks     ║\n",
+           sim->switch_count, sim->overhead_ticks);
+
+    // Prazos (apenas se alguma tarefa tiver prazo)
+    int with_deadline = 0;
+    int max_lateness = INT_MIN;
+    for (int i = 0; i < sim->static_count; i++) {
+        if (sim->tasks[i].abs_deadline >= 0) {
+            with_deadline++;
+            if (sim->tasks[i].lateness > max_lateness) {
+                max_lateness = sim->tasks[i].lateness;
+            }
+        }
+    }
+    if (with_deadline > 0) {
+        printf("║ Prazos:  Perdidos = %3d de %-3d |  Atraso máximo = %6d     ║\n",
+               sim->miss_count, with_deadline, max_lateness);
+    }
     printf("╚══════════════════════════════════════════════════════════════╝\n");
+
+    print_periodic_statistics(sim);
+    print_share_statistics(sim);
+}
+
+/**
+ * Monta os marcadores de prazo para o BMP: um marcador por prazo e um
+ * marcador de perda para cada tarefa comum que terminou depois do prazo
+ * (as perdas de jobs periódicos aparecem na tabela de tarefas periódicas).
+ *
+ * @param count Recebe o número de marcadores
+ * @return Array alocado (liberar com free) ou NULL se não houver prazos
+ */
+GanttMarker* build_deadline_markers(Simulator* sim, int* count) {
+    int total = sim->miss_count;
+    for (int i = 0; i < sim->static_count; i++) {
+        if (sim->tasks[i].abs_deadline >= 0) total++;
+    }
+
+    *count = 0;
+    if (total == 0) return NULL;
+
+    GanttMarker* markers = malloc(total * sizeof(GanttMarker));
+    for (int i = 0; i < sim->static_count; i++) {
+        if (sim->tasks[i].abs_deadline >= 0) {
+            markers[*count].task_id = i;
+            markers[*count].time = sim->tasks[i].abs_deadline;
+            markers[*count].kind = GANTT_MARK_DEADLINE;
+            (*count)++;
+        }
+    }
+    for (int i = 0; i < sim->static_count; i++) {
+        if (sim->tasks[i].deadline_missed) {
+            markers[*count].task_id = i;
+            markers[*count].time = sim->tasks[i].abs_deadline;
+            markers[*count].kind = GANTT_MARK_MISS;
+            (*count)++;
+        }
+    }
+    return markers;
 }
 
 /**
@@ -1356,12 +3744,34 @@ void print_usage(const char* program) {
     printf("  --step       Modo passo-a-passo (debug)\n");
     printf("  --bmp        Gerar gráfico BMP automaticamente\n");
     printf("  --ascii      Exibir gráfico ASCII automaticamente\n");
+    printf("  --ascii-start N    Primeiro tick do gráfico ASCII (padrão 0)\n");
+    printf("  --ascii-width N    Colunas do gráfico ASCII (padrão 60)\n");
+    printf("  --ascii-scale N    Ticks por coluna no ASCII (padrão 1, 0 = até o fim)\n");
+    printf("  --svg        Exportar o Gantt em SVG (gantt_output.svg)\n");
+    printf("  --html       Exportar o Gantt em HTML com zoom (gantt_output.html)\n");
+    printf("  --svg-merge  No SVG/HTML, juntar execuções a menos de 1 pixel\n");
     printf("  --quiet      Não mostrar mensagens de execução\n");
+    printf("  --horizon N  Simular tarefas periódicas até o tick N\n");
+    printf("  --seed N     Semente do sorteio do LOTTERY (padrão %d)\n", DEFAULT_SEED);
+    printf("  --switch-cost N    Ticks gastos em cada troca de contexto\n");
+    printf("  --cache-penalty N  Ticks extras ao retomar uma tarefa (cache frio)\n");
+    printf("  --disk-history     Guardar o histórico do modo debug em arquivo temporário\n");
+    printf("  --play-rate N      Ticks por segundo do comando 'p' do modo debug (padrão %d)\n",
+           DEFAULT_PLAY_RATE);
+    printf("  --runs N     Repetir a simulação N vezes (sementes consecutivas)\n");
+    printf("  --summary    Estatísticas só em resumo (média, desvio e percentis),\n");
+    printf("               sem tabela por tarefa; vale também com --quiet\n");
+    printf("  --bmp-width N      Largura máxima do BMP; acima dela os ticks são\n");
+    printf("                     agrupados por pixel (padrão %d, 0 = sem limite)\n", DEFAULT_BMP_WIDTH);
+    printf("  --bmp-threads N    Threads para desenhar o BMP (padrão: automático)\n");
+    printf("  --image-format F   Formato da imagem: bmp (padrão), bmp8 (paleta),\n");
+    printf("                     rle8 (paleta comprimida) ou png\n");
     printf("  --help       Mostrar esta ajuda\n");
     printf("\nFormato do arquivo de configuração:\n");
     printf("  algoritmo;quantum\n");
-    printf("  id;cor;chegada;duracao;prioridade;[eventos]\n");
-    printf("\nAlgoritmos suportados: FIFO, RR, SRTF, PRIORITY\n");
+    printf("  id;cor;chegada;duracao;prioridade;[eventos][;deadline][;bilhetes]\n");
+    printf("  P;id;cor;periodo;fase;wcet;prioridade[;deadline][;bilhetes]   (periódica)\n");
+    printf("\nAlgoritmos suportados: FIFO, RR, SRTF, PRIORITY, EDF, LOTTERY, STRIDE\n");
     printf("\nExemplo:\n");
     printf("  RR;5\n");
     printf("  0;#FF0000;0;10;1;\n");
@@ -1381,7 +3791,22 @@ int main(int argc, char* argv[]) {
     bool step_mode = false;
     bool auto_bmp = false;
     bool auto_ascii = false;
+    bool auto_svg = false;
+    bool auto_html = false;
+    bool svg_merge = false;
     bool quiet = false;
+    bool summary_only = false;
+    int horizon = 0;
+    long seed = -1;
+    int switch_cost = 0;
+    int cache_penalty = 0;
+    bool disk_history = false;
+    int runs = 1;
+    int bmp_width = DEFAULT_BMP_WIDTH;
+    int bmp_threads = 0;
+    int play_rate = DEFAULT_PLAY_RATE;
+    GanttImageFormat image_format = GANTT_IMAGE_BMP24;
+    GanttViewport ascii_view = {0, 0, 1};
 
     for (int i = 1; i < argc; i++) {
         if (strcmp(argv[i], "--help") == 0 || strcmp(argv[i], "-h") == 0) {
@@ -1397,9 +3822,112 @@ int main(int argc, char* argv[]) {
         else if (strcmp(argv[i], "--ascii") == 0) {
             auto_ascii = true;
         }
+        else if (strcmp(argv[i], "--svg") == 0) {
+            auto_svg = true;
+        }
+        else if (strcmp(argv[i], "--html") == 0) {
+            auto_html = true;
+        }
+        else if (strcmp(argv[i], "--svg-merge") == 0) {
+            svg_merge = true;
+        }
         else if (strcmp(argv[i], "--quiet") == 0) {
             quiet = true;
         }
+        else if (strcmp(argv[i], "--summary") == 0) {
+            summary_only = true;
+        }
+        else if (strcmp(argv[i], "--horizon") == 0 && i + 1 < argc) {
+            horizon = atoi(argv[++i]);
+            if (horizon <= 0) {
+                printf("Erro: Horizonte inválido '%s'\n", argv[i]);
+                return 1;
+            }
+        }
+        else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = strtol(argv[++i], NULL, 10);
+            if (seed < 0) {
+                printf("Erro: Semente inválida '%s'\n", argv[i]);
+                return 1;
+            }
+        }
+        else if (strcmp(argv[i], "--switch-cost") == 0 && i + 1 < argc) {
+            switch_cost = atoi(argv[++i]);
+            if (switch_cost < 0) {
+                printf("Erro: Custo de troca inválido '%s'\n", argv[i]);
+                return 1;
+            }
+        }
+        else if (strcmp(argv[i], "--cache-penalty") == 0 && i + 1 < argc) {
+            cache_penalty = atoi(argv[++i]);
+            if (cache_penalty < 0) {
+                printf("Erro: Penalidade de cache inválida '%s'\n", argv[i]);
+                return 1;
+            }
+        }
+        else if (strcmp(argv[i], "--disk-history") == 0) {
+            disk_history = true;
+        }
+        else if (strcmp(argv[i], "--runs") == 0 && i + 1 < argc) {
+            runs = atoi(argv[++i]);
+            if (runs <= 0) {
+                printf("Erro: Número de execuções inválido '%s'\n", argv[i]);
+                return 1;
+            }
+        }
+        else if (strcmp(argv[i], "--ascii-start") == 0 && i + 1 < argc) {
+            ascii_view.start = atoi(argv[++i]);
+            if (ascii_view.start < 0) {
+                printf("Erro: Tick inicial inválido '%s'\n", argv[i]);
+                return 1;
+            }
+        }
+        else if (strcmp(argv[i], "--ascii-width") == 0 && i + 1 < argc) {
+            ascii_view.width = atoi(argv[++i]);
+            if (ascii_view.width <= 0) {
+                printf("Erro: Largura inválida '%s'\n", argv[i]);
+                return 1;
+            }
+        }
+        else if (strcmp(argv[i], "--ascii-scale") == 0 && i + 1 < argc) {
+            ascii_view.scale = atoi(argv[++i]);
+            if (ascii_view.scale < 0) {
+                printf("Erro: Escala inválida '%s'\n", argv[i]);
+                return 1;
+            }
+        }
+        else if (strcmp(argv[i], "--bmp-width") == 0 && i + 1 < argc) {
+            bmp_width = atoi(argv[++i]);
+            if (bmp_width < 0) {
+                printf("Erro: Largura inválida '%s'\n", argv[i]);
+                return 1;
+            }
+        }
+        else if (strcmp(argv[i], "--image-format") == 0 && i + 1 < argc) {
+            const char* name = argv[++i];
+            if (strcmp(name, "bmp") == 0) image_format = GANTT_IMAGE_BMP24;
+            else if (strcmp(name, "bmp8") == 0) image_format = GANTT_IMAGE_BMP8;
+            else if (strcmp(name, "rle8") == 0) image_format = GANTT_IMAGE_RLE8;
+            else if (strcmp(name, "png") == 0) image_format = GANTT_IMAGE_PNG;
+            else {
+                printf("Erro: Formato de imagem desconhecido '%s'\n", name);
+                return 1;
+            }
+        }
+        else if (strcmp(argv[i], "--play-rate") == 0 && i + 1 < argc) {
+            play_rate = atoi(argv[++i]);
+            if (play_rate <= 0) {
+                printf("Erro: Velocidade inválida '%s'\n", argv[i]);
+                return 1;
+            }
+        }
+        else if (strcmp(argv[i], "--bmp-threads") == 0 && i + 1 < argc) {
+            bmp_threads = atoi(argv[++i]);
+            if (bmp_threads < 0) {
+                printf("Erro: Número de threads inválido '%s'\n", argv[i]);
+                return 1;
+            }
+        }
         else if (argv[i][0] != '-') {
             config_file = argv[i];
         }
@@ -1416,13 +3944,28 @@ int main(int argc, char* argv[]) {
     if (!config) {
         return 1;
     }
+    if (horizon > 0) {
+        config->horizon = horizon;
+    }
+    if (seed >= 0) {
+        config->seed = (unsigned int)seed;
+    }
+    config->switch_cost = switch_cost;
+    config->cache_penalty = cache_penalty;
+    config->disk_history = disk_history;
+    config->history = step_mode;  // Só o modo debug retrocede
+
+    if (step_mode && runs > 1) {
+        printf("Erro: --runs não pode ser usado com --step\n");
+        free_config(config);
+        return 1;
+    }
 
     // Criar simulador
     Simulator* sim = create_simulator(config);
     if (!sim) {
         printf("Erro: Falha ao criar simulador\n");
-        free(config->tasks);
-        free(config);
+        free_config(config);
         return 1;
     }
 
@@ -1430,7 +3973,9 @@ int main(int argc, char* argv[]) {
 
     // Executar simulação
     if (step_mode) {
-        run_step_by_step(sim);
+        run_step_by_step(sim, play_rate);
+    } else if (runs > 1) {
+        run_repeated(sim, config, runs);
     } else {
         run_complete(sim);
     }
@@ -1438,12 +3983,15 @@ int main(int argc, char* argv[]) {
     int max_time = sim->clock.current_tick;
 
     // Estatísticas
-    if (!quiet) {
+    if (summary_only) {
+        print_statistics_summary(sim);
+    } else if (!quiet) {
         if (!auto_bmp && !auto_ascii) {
             // Modo interativo
             if (ask_yes_no("\nExibir estatísticas detalhadas?")) {
-                TaskStats* stats = malloc(sim->task_count * sizeof(TaskStats));
-                for (int i = 0; i < sim->task_count; i++) {
+                // Jobs periódicos têm tabela própria (print_periodic_statistics)
+                TaskStats* stats = malloc((sim->static_count + 1) * sizeof(TaskStats));
+                for (int i = 0; i < sim->static_count; i++) {
                     TCB* t = &sim->tasks[i];
                     stats[i].id = t->id;
                     stats[i].arrival = t->arrival_time;
@@ -1453,11 +4001,17 @@ int main(int argc, char* argv[]) {
                     stats[i].waiting = t->waiting_time;
                     stats[i].response = t->response_time;
                     stats[i].priority = t->priority;
+                    stats[i].deadline = t->abs_deadline;
+                    stats[i].lateness = t->lateness;
+                    stats[i].missed = t->deadline_missed;
                 }
-                show_statistics(stats, sim->task_count, sim->algorithm);
+                show_statistics(stats, sim->static_count, sim->algorithm);
+                print_switch_statistics(sim);
+                print_periodic_statistics(sim);
+                print_share_statistics(sim);
 
                 if (ask_yes_no("Exportar estatísticas para CSV?")) {
-                    export_to_csv(stats, sim->task_count, sim->algorithm);
+                    export_to_csv(stats, sim->static_count, sim->algorithm);
                 }
                 free(stats);
             } else {
@@ -1470,19 +4024,46 @@ int main(int argc, char* argv[]) {
 
     // Gantt ASCII
     if (auto_ascii || (!quiet && !auto_bmp && ask_yes_no("\nExibir Gantt Chart ASCII?"))) {
-        print_gantt_ascii(sim->gantt_entries, sim->gantt_count, max_time, sim->task_count);
+        print_gantt_ascii(sim->gantt.entries, sim->gantt.count, max_time, sim->row_count,
+                          &sim->gantt.palette, &ascii_view);
     }
 
     // Gantt BMP
     if (auto_bmp || (!quiet && ask_yes_no("\nGerar gráfico de Gantt (BMP)?"))) {
-        create_gantt_bmp("gantt_output.bmp", sim->gantt_entries,
-                        sim->gantt_count, max_time, sim->task_count);
+        GanttBmpOptions bmp_options = {0};
+        bmp_options.markers = build_deadline_markers(sim, &bmp_options.marker_count);
+        bmp_options.max_width = bmp_width;
+        bmp_options.threads = bmp_threads;
+        bmp_options.format = image_format;
+        const char* image_file = (image_format == GANTT_IMAGE_PNG) ? "gantt_output.png"
+                                                                   : "gantt_output.bmp";
+        create_gantt_bmp_ex(image_file, sim->gantt.entries,
+                            sim->gantt.count, max_time, sim->row_count,
+                            &sim->gantt.palette, &bmp_options);
+        free((GanttMarker*)bmp_options.markers);
+    }
+
+    // Gantt SVG / HTML
+    if (auto_svg || auto_html) {
+        GanttSvgOptions svg_options = {0};
+        svg_options.markers = build_deadline_markers(sim, &svg_options.marker_count);
+        svg_options.max_width = bmp_width;
+        svg_options.merge = svg_merge;
+        if (auto_svg) {
+            create_gantt_svg("gantt_output.svg", sim->gantt.entries, sim->gantt.count,
+                             max_time, sim->row_count, &sim->gantt.palette, &svg_options);
+        }
+        if (auto_html) {
+            svg_options.html = 1;
+            create_gantt_svg("gantt_output.html", sim->gantt.entries, sim->gantt.count,
+                             max_time, sim->row_count, &sim->gantt.palette, &svg_options);
+        }
+        free((GanttMarker*)svg_options.markers);
     }
 
     // Liberar memória
     destroy_simulator(sim);
-    free(config->tasks);
-    free(config);
+    free_config(config);
 
     return 0;
 }
\ No newline at end of file
@@ -29,8 +29,85 @@ void draw_bar(int value, int max_value, int width, const char* color) {
     printf(" %d", value);
 }
 
+// Ordenar perdas de prazo cronologicamente (por prazo)
+static int compare_miss(const void* a, const void* b) {
+    const TaskStats* ta = *(const TaskStats* const*)a;
+    const TaskStats* tb = *(const TaskStats* const*)b;
+    if (ta->deadline != tb->deadline) return (ta->deadline < tb->deadline) ? -1 : 1;
+    return ta->id - tb->id;
+}
+
+// Exibir análise de prazos (apenas se alguma tarefa tiver prazo)
+static void show_deadline_analysis(TaskStats* tasks, int count) {
+    int with_deadline = 0;
+    int miss_count = 0;
+    int max_lateness = 0;
+    int total_lateness = 0;
+    int end_time = 0;
+
+    for (int i = 0; i < count; i++) {
+        if (tasks[i].completion > end_time) end_time = tasks[i].completion;
+        if (tasks[i].deadline < 0) continue;
+
+        if (with_deadline == 0 || tasks[i].lateness > max_lateness) {
+            max_lateness = tasks[i].lateness;
+        }
+        with_deadline++;
+        total_lateness += tasks[i].lateness;
+        if (tasks[i].missed) miss_count++;
+    }
+
+    if (with_deadline == 0) return;
+
+    printf("\n" BOLD "PRAZOS (DEADLINES):\n" RESET);
+    printf("───────────────────\n");
+    printf("• Tarefas com prazo: " YELLOW "%d" RESET "\n", with_deadline);
+    printf("• Prazos perdidos: %s%d" RESET " (%.1f%%)\n",
+           miss_count > 0 ? RED : GREEN, miss_count,
+           100.0f * miss_count / with_deadline);
+    printf("• Atraso médio (lateness): " YELLOW "%.2f" RESET " ticks\n",
+           (float)total_lateness / with_deadline);
+    printf("• Atraso máximo: " YELLOW "%d" RESET " ticks\n", max_lateness);
+
+    if (miss_count == 0) {
+        printf(GREEN "✓" RESET " Todos os prazos foram cumpridos\n");
+        return;
+    }
+
+    // Linha do tempo das perdas, em ordem cronológica
+    const TaskStats** missed = malloc(miss_count * sizeof(TaskStats*));
+    int n = 0;
+    for (int i = 0; i < count; i++) {
+        if (tasks[i].deadline >= 0 && tasks[i].missed) missed[n++] = &tasks[i];
+    }
+    qsort(missed, n, sizeof(TaskStats*), compare_miss);
+
+    printf("\n" BOLD "LINHA DO TEMPO DE PERDAS:\n" RESET);
+    int width = 50;
+    char strip[51];
+    memset(strip, '-', width);
+    strip[width] = '\0';
+    for (int i = 0; i < n; i++) {
+        int pos = (end_time > 0) ? (int)((long long)missed[i]->deadline * (width - 1) / end_time) : 0;
+        if (pos >= 0 && pos < width) strip[pos] = '!';
+    }
+    printf("  0 " RED "%s" RESET " %d\n", strip, end_time);
+
+    for (int i = 0; i < n; i++) {
+        printf("  t=%-5d " RED "✗" RESET " T%-2d terminou em %d (atraso: %d)\n",
+               missed[i]->deadline, missed[i]->id,
+               missed[i]->completion, missed[i]->lateness);
+    }
+    free(missed);
+}
+
 // Calcular e exibir estatísticas
 void show_statistics(TaskStats* tasks, int count, const char* algorithm) {
+    if (count <= 0) {
+        printf("\nNenhuma tarefa comum para analisar.\n");
+        return;
+    }
+
     printf("\n" BOLD "═══════════════════════════════════════════════════════════\n");
     printf("                  ANÁLISE DE DESEMPENHO - %s\n", algorithm);
     printf("═══════════════════════════════════════════════════════════\n" RESET);
@@ -133,6 +210,8 @@ void show_statistics(TaskStats* tasks, int count, const char* algorithm) {
         printf(GREEN "✓" RESET " Nenhum problema de starvation detectado\n");
     }
 
+    show_deadline_analysis(tasks, count);
+
     // Convoy effect check (para FIFO)
     if (strcmp(algorithm, "FIFO") == 0) {
         int convoy = 0;
@@ -159,9 +238,9 @@ void export_to_csv(TaskStats* tasks, int count, const char* algorithm) {
     FILE* f = fopen(filename, "w");
     if (!f) return;
 
-    fprintf(f, "ID,Arrival,Burst,Priority,Completion,Turnaround,Waiting\n");
+    fprintf(f, "ID,Arrival,Burst,Priority,Completion,Turnaround,Waiting,Deadline,Lateness,Missed\n");
     for (int i = 0; i < count; i++) {
-        fprintf(f, "%d,%d,%d,%d,%d,%d,%d\n",
+        fprintf(f, "%d,%d,%d,%d,%d,%d,%d,",
                 tasks[i].id,
                 tasks[i].arrival,
                 tasks[i].burst,
@@ -169,19 +248,164 @@ void export_to_csv(TaskStats* tasks, int count, const char* algorithm) {
                 tasks[i].completion,
                 tasks[i].turnaround,
                 tasks[i].waiting);
+        if (tasks[i].deadline >= 0) {
+            fprintf(f, "%d,%d,%d\n", tasks[i].deadline, tasks[i].lateness, tasks[i].missed);
+        } else {
+            fprintf(f, ",,\n");
+        }
     }
 
     fclose(f);
     printf(GREEN "✓" RESET " Estatísticas exportadas para: %s\n", filename);
 }
 
+// Faixa do histograma de um valor: exata abaixo de 2 * STAT_SUB_BUCKETS,
+// depois STAT_SUB_BUCKETS faixas por potência de 2
+static int stat_bucket(int value) {
+    if (value < 2 * STAT_SUB_BUCKETS) return value;
+    int shift = 1;
+    while ((value >> shift) >= 2 * STAT_SUB_BUCKETS) shift++;
+    return (shift + 1) * STAT_SUB_BUCKETS + (value >> shift) - STAT_SUB_BUCKETS;
+}
+
+// Valor que representa uma faixa (o meio dela)
+static int stat_bucket_value(int bucket) {
+    if (bucket < 2 * STAT_SUB_BUCKETS) return bucket;
+    int shift = bucket / STAT_SUB_BUCKETS - 1;
+    long long low = (long long)(bucket % STAT_SUB_BUCKETS + STAT_SUB_BUCKETS) << shift;
+    long long mid = low + ((1LL << shift) - 1) / 2;
+    return (mid > 2147483647LL) ? 2147483647 : (int)mid;
+}
+
+void stat_stream_reset(StatStream* s) {
+    memset(s, 0, sizeof(StatStream));
+}
+
+void stat_stream_add(StatStream* s, int value) {
+    if (value < 0) value = 0;
+
+    s->count++;
+    double delta = value - s->mean;
+    s->mean += delta / s->count;
+    s->m2 += delta * (value - s->mean);
+
+    if (s->count == 1 || value < s->min) s->min = value;
+    if (s->count == 1 || value > s->max) s->max = value;
+    s->buckets[stat_bucket(value)]++;
+}
+
+// Junta dois acumuladores (fórmula de Chan para a variância combinada)
+void stat_stream_merge(StatStream* into, const StatStream* from) {
+    if (from->count == 0) return;
+    if (into->count == 0) {
+        *into = *from;
+        return;
+    }
+
+    long long count = into->count + from->count;
+    double delta = from->mean - into->mean;
+    into->m2 += from->m2 + delta * delta * into->count * from->count / count;
+    into->mean += delta * from->count / count;
+    into->count = count;
+
+    if (from->min < into->min) into->min = from->min;
+    if (from->max > into->max) into->max = from->max;
+    for (int b = 0; b < STAT_BUCKETS; b++) {
+        into->buckets[b] += from->buckets[b];
+    }
+}
+
+double stat_stream_stddev(const StatStream* s) {
+    return (s->count > 1) ? sqrt(s->m2 / s->count) : 0.0;
+}
+
+int stat_stream_percentile(const StatStream* s, double q) {
+    if (s->count == 0) return 0;
+
+    // Posição (a partir de 1) do valor procurado na ordem crescente
+    long long rank = (long long)ceil(q * s->count);
+    if (rank < 1) rank = 1;
+    if (rank > s->count) rank = s->count;
+
+    long long seen = 0;
+    for (int b = 0; b < STAT_BUCKETS; b++) {
+        seen += s->buckets[b];
+        if (seen >= rank) {
+            // A faixa pode passar dos extremos observados
+            int value = stat_bucket_value(b);
+            if (value < s->min) value = s->min;
+            if (value > s->max) value = s->max;
+            return value;
+        }
+    }
+    return s->max;
+}
+
+void task_summary_reset(TaskSummary* summary) {
+    stat_stream_reset(&summary->turnaround);
+    stat_stream_reset(&summary->waiting);
+    stat_stream_reset(&summary->response);
+}
+
+void task_summary_add(TaskSummary* summary, int turnaround, int waiting, int response) {
+    stat_stream_add(&summary->turnaround, turnaround);
+    stat_stream_add(&summary->waiting, waiting);
+    stat_stream_add(&summary->response, response);
+}
+
+void task_summary_merge(TaskSummary* into, const TaskSummary* from) {
+    stat_stream_merge(&into->turnaround, &from->turnaround);
+    stat_stream_merge(&into->waiting, &from->waiting);
+    stat_stream_merge(&into->response, &from->response);
+}
+
+static void show_summary_row(const char* name, const StatStream* s) {
+    printf("%-11s %10.2f %9.2f %8d %8d %8d %8d %8d %8d\n",
+           name, s->mean, stat_stream_stddev(s), s->min,
+           stat_stream_percentile(s, 0.50), stat_stream_percentile(s, 0.95),
+           stat_stream_percentile(s, 0.99), stat_stream_percentile(s, 0.999), s->max);
+}
+
+// Exibir resumo das métricas (tamanho fixo, qualquer número de tarefas)
+void show_summary(const TaskSummary* summary, long long periodic_jobs,
+                  const char* algorithm, int total_time) {
+    long long count = summary->turnaround.count;
+
+    printf("\n" BOLD "═══════════════════════════════════════════════════════════════════════════════\n");
+    printf("                       RESUMO DE DESEMPENHO - %s\n", algorithm);
+    printf("═══════════════════════════════════════════════════════════════════════════════\n" RESET);
+
+    if (count == 0) {
+        printf("Nenhuma tarefa concluída.\n");
+        return;
+    }
+
+    printf("• Tarefas concluídas: " YELLOW "%lld" RESET " em %d ticks", count, total_time);
+    if (total_time > 0) {
+        printf(" (throughput: " YELLOW "%.3f" RESET " tarefas/tick)", (double)count / total_time);
+    }
+    printf("\n");
+    if (periodic_jobs > 0) {
+        printf("• Jobs periódicos entre elas: " YELLOW "%lld" RESET "\n", periodic_jobs);
+    }
+    printf("\n");
+
+    // Larguras +1 nos nomes acentuados (2 bytes por letra acentuada)
+    printf(CYAN "%-12s %11s %9s %9s %8s %8s %8s %8s %9s\n" RESET,
+           "Métrica", "Média", "Desvio", "Mín", "p50", "p95", "p99", "p99.9", "Máx");
+    show_summary_row("Turnaround", &summary->turnaround);
+    show_summary_row("Espera", &summary->waiting);
+    show_summary_row("Resposta", &summary->response);
+    printf("\nPercentis com erro relativo abaixo de 1,6%% (exatos até 127 ticks).\n");
+}
+
 #ifdef STANDALONE_TEST
 int main() {
     // Dados de exemplo
     TaskStats tasks[] = {
-        {0, 0, 20, 20, 20, 0, 0, 1},
-        {1, 5, 15, 35, 30, 15, 5, 2},
-        {2, 10, 10, 45, 35, 25, 10, 3}
+        {0, 0, 20, 20, 20, 0, 0, 1, 25, -5, 0},
+        {1, 5, 15, 35, 30, 15, 5, 2, 30, 5, 1},
+        {2, 10, 10, 45, 35, 25, 10, 3, -1, 0, 0}
     };
 
     show_statistics(tasks, 3, "FIFO");
@@ -13,10 +13,53 @@ typedef struct {
     int waiting;
     int response;
     int priority;
+    int deadline;     // Prazo absoluto (-1 = sem prazo)
+    int lateness;     // Término - prazo (negativo = adiantada)
+    int missed;       // 1 se terminou depois do prazo
 } TaskStats;
 
+// Acumulador de uma métrica (em ticks), atualizado a cada tarefa concluída
+// sem guardar as tarefas: média e variância pelo método de Welford e um
+// histograma log-linear (no estilo do HDR histogram) para os percentis.
+// A memória é fixa para qualquer número de tarefas: valores até 127 ficam
+// exatos e os maiores em faixas de 1/64 da sua potência de 2 (erro
+// relativo abaixo de 1,6%).
+#define STAT_SUB_BUCKETS  64
+#define STAT_BUCKETS      (26 * STAT_SUB_BUCKETS)   // Até INT_MAX
+
+typedef struct {
+    long long count;
+    double mean;
+    double m2;        // Soma dos quadrados dos desvios da média (Welford)
+    int min;
+    int max;
+    unsigned long long buckets[STAT_BUCKETS];
+} StatStream;
+
+// Métricas das tarefas concluídas (comuns ou jobs periódicos)
+typedef struct {
+    StatStream turnaround;
+    StatStream waiting;
+    StatStream response;
+} TaskSummary;
+
 // Funções públicas que serão chamadas pelo simulador.c
 void show_statistics(TaskStats* tasks, int count, const char* algorithm);
 void export_to_csv(TaskStats* tasks, int count, const char* algorithm);
 
+void stat_stream_reset(StatStream* s);
+void stat_stream_add(StatStream* s, int value);       // Negativos contam como 0
+void stat_stream_merge(StatStream* into, const StatStream* from);
+double stat_stream_stddev(const StatStream* s);
+int stat_stream_percentile(const StatStream* s, double q);   // 0 < q <= 1
+
+void task_summary_reset(TaskSummary* summary);
+void task_summary_add(TaskSummary* summary, int turnaround, int waiting, int response);
+void task_summary_merge(TaskSummary* into, const TaskSummary* from);
+
+// Resumo sem tabela por tarefa: média, desvio, mínimo, percentis e máximo.
+// periodic_jobs: quantos dos concluídos em summary são jobs periódicos
+void show_summary(const TaskSummary* summary, long long periodic_jobs,
+                  const char* algorithm, int total_time);
+
 #endif // STATS_VIEWER_H
\ No newline at end of file
@@ -0,0 +1,156 @@
+/*
+ * task_heap.c - Heap binário mínimo indexado por tarefa
+ * -----------------------------------------------------
+ * Estrutura usada pelos escalonadores que precisam escolher a tarefa de
+ * menor chave (prazo, passo, etc.) em tempo logarítmico, mesmo com
+ * milhares de tarefas prontas.
+ *
+ * NOTA: Todas as funções auxiliares são marcadas como 'static'
+ * para evitar conflitos com outros módulos.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "task_heap.h"
+
+/* ============================================================================
+ * FUNÇÕES AUXILIARES (STATIC - locais ao arquivo)
+ * ============================================================================ */
+
+/**
+ * Compara duas posições do heap: menor chave primeiro, depois menor índice
+ */
+static bool heap_less(const TaskHeap* h, int a, int b) {
+    if (h->keys[a] != h->keys[b]) return h->keys[a] < h->keys[b];
+    return h->items[a] < h->items[b];
+}
+
+/**
+ * Troca duas posições do heap mantendo o mapa de posições coerente
+ */
+static void heap_swap(TaskHeap* h, int a, int b) {
+    int item = h->items[a];
+    long long key = h->keys[a];
+
+    h->items[a] = h->items[b];
+    h->keys[a] = h->keys[b];
+    h->items[b] = item;
+    h->keys[b] = key;
+
+    h->pos[h->items[a]] = a;
+    h->pos[h->items[b]] = b;
+}
+
+static void heap_sift_up(TaskHeap* h, int i) {
+    while (i > 0) {
+        int parent = (i - 1) / 2;
+        if (!heap_less(h, i, parent)) break;
+        heap_swap(h, i, parent);
+        i = parent;
+    }
+}
+
+static void heap_sift_down(TaskHeap* h, int i) {
+    for (;;) {
+        int left = 2 * i + 1;
+        int right = left + 1;
+        int smallest = i;
+
+        if (left < h->count && heap_less(h, left, smallest)) smallest = left;
+        if (right < h->count && heap_less(h, right, smallest)) smallest = right;
+        if (smallest == i) break;
+
+        heap_swap(h, i, smallest);
+        i = smallest;
+    }
+}
+
+/* ============================================================================
+ * FUNÇÕES PÚBLICAS
+ * ============================================================================ */
+
+void task_heap_init(TaskHeap* h, int capacity) {
+    memset(h, 0, sizeof(TaskHeap));
+    task_heap_reserve(h, capacity);
+}
+
+void task_heap_free(TaskHeap* h) {
+    free(h->items);
+    free(h->keys);
+    free(h->pos);
+    memset(h, 0, sizeof(TaskHeap));
+}
+
+void task_heap_reserve(TaskHeap* h, int capacity) {
+    if (capacity <= h->capacity) return;
+
+    int new_capacity = (h->capacity > 0) ? h->capacity : 16;
+    while (new_capacity < capacity) new_capacity *= 2;
+
+    h->items = realloc(h->items, new_capacity * sizeof(int));
+    h->keys = realloc(h->keys, new_capacity * sizeof(long long));
+    h->pos = realloc(h->pos, new_capacity * sizeof(int));
+
+    for (int i = h->capacity; i < new_capacity; i++) {
+        h->pos[i] = -1;
+    }
+    h->capacity = new_capacity;
+}
+
+void task_heap_clear(TaskHeap* h) {
+    for (int i = 0; i < h->count; i++) {
+        h->pos[h->items[i]] = -1;
+    }
+    h->count = 0;
+}
+
+void task_heap_push(TaskHeap* h, int idx, long long key) {
+    if (idx < 0) return;
+    task_heap_reserve(h, idx + 1);
+
+    int i = h->pos[idx];
+    if (i >= 0) {
+        /* Já presente: apenas reposicionar com a nova chave */
+        long long old_key = h->keys[i];
+        h->keys[i] = key;
+        if (key < old_key) heap_sift_up(h, i);
+        else heap_sift_down(h, i);
+        return;
+    }
+
+    i = h->count++;
+    h->items[i] = idx;
+    h->keys[i] = key;
+    h->pos[idx] = i;
+    heap_sift_up(h, i);
+}
+
+void task_heap_remove(TaskHeap* h, int idx) {
+    if (!task_heap_contains(h, idx)) return;
+
+    int i = h->pos[idx];
+    int last = --h->count;
+
+    if (i != last) {
+        heap_swap(h, i, last);
+        h->pos[idx] = -1;
+        heap_sift_up(h, i);
+        heap_sift_down(h, i);
+    } else {
+        h->pos[idx] = -1;
+    }
+}
+
+int task_heap_peek(const TaskHeap* h) {
+    return (h->count > 0) ? h->items[0] : -1;
+}
+
+int task_heap_pop(TaskHeap* h) {
+    int top = task_heap_peek(h);
+    if (top >= 0) task_heap_remove(h, top);
+    return top;
+}
+
+bool task_heap_contains(const TaskHeap* h, int idx) {
+    return idx >= 0 && idx < h->capacity && h->pos[idx] >= 0;
+}
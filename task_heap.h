@@ -0,0 +1,51 @@
+/*
+ * task_heap.h - Heap binário mínimo indexado por tarefa
+ *
+ * Guarda índices de tarefas (posições no array de TCBs) ordenados por uma
+ * chave inteira de 64 bits. Cada índice aparece no máximo uma vez, e o
+ * mapa de posições permite remover ou reordenar uma tarefa em O(log n).
+ * Empates de chave são desempatados pelo índice, o que torna a ordem de
+ * retirada totalmente determinística.
+ */
+
+#ifndef TASK_HEAP_H
+#define TASK_HEAP_H
+
+#include <stdbool.h>
+
+typedef struct {
+    int* items;         /* Índices das tarefas em ordem de heap */
+    long long* keys;    /* Chave de cada posição (paralelo a items) */
+    int* pos;           /* Posição de cada índice no heap (-1 = ausente) */
+    int count;          /* Número de elementos no heap */
+    int capacity;       /* Maior índice suportado + 1 */
+} TaskHeap;
+
+/* Inicializa um heap vazio capaz de guardar índices em [0, capacity) */
+void task_heap_init(TaskHeap* h, int capacity);
+
+/* Libera a memória do heap */
+void task_heap_free(TaskHeap* h);
+
+/* Garante espaço para índices em [0, capacity) */
+void task_heap_reserve(TaskHeap* h, int capacity);
+
+/* Esvazia o heap mantendo a memória alocada */
+void task_heap_clear(TaskHeap* h);
+
+/* Insere um índice com a chave dada (ou atualiza a chave se já presente) */
+void task_heap_push(TaskHeap* h, int idx, long long key);
+
+/* Remove um índice do heap (sem efeito se ausente) */
+void task_heap_remove(TaskHeap* h, int idx);
+
+/* Retorna o índice de menor chave sem removê-lo (-1 se vazio) */
+int task_heap_peek(const TaskHeap* h);
+
+/* Remove e retorna o índice de menor chave (-1 se vazio) */
+int task_heap_pop(TaskHeap* h);
+
+/* Verifica se o índice está no heap */
+bool task_heap_contains(const TaskHeap* h, int idx);
+
+#endif /* TASK_HEAP_H */
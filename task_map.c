@@ -0,0 +1,122 @@
+/*
+ * task_map.c - Mapa de ids de tarefa para posições
+ * ------------------------------------------------
+ * O id passa por uma mistura de bits antes de escolher a posição: ids
+ * sequenciais ou múltiplos de uma potência de 2 (comuns em PIDs) se
+ * espalham pela tabela em vez de colidirem nos mesmos bits baixos.
+ *
+ * NOTA: Todas as funções auxiliares são marcadas como 'static'
+ * para evitar conflitos com outros módulos.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "task_map.h"
+
+#define TASK_MAP_MIN_CAPACITY 16
+
+/* ============================================================================
+ * FUNÇÕES AUXILIARES (STATIC - locais ao arquivo)
+ * ============================================================================ */
+
+static uint32_t map_hash(int id) {
+    uint32_t h = (uint32_t)id;
+    h ^= h >> 16;
+    h *= 0x45D9F3Bu;
+    h ^= h >> 16;
+    h *= 0x45D9F3Bu;
+    h ^= h >> 16;
+    return h;
+}
+
+/**
+ * Posição do id na tabela: a que o contém ou a primeira livre
+ */
+static int map_slot(const TaskMap* map, int id) {
+    int mask = map->capacity - 1;
+    int slot = (int)(map_hash(id) & (uint32_t)mask);
+    while (map->values[slot] >= 0 && map->keys[slot] != id) {
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+/**
+ * Troca a tabela por outra com capacity posições, reinserindo os ids
+ */
+static int map_rehash(TaskMap* map, int capacity) {
+    int* keys = malloc(capacity * sizeof(int));
+    int* values = malloc(capacity * sizeof(int));
+    if (!keys || !values) {
+        free(keys);
+        free(values);
+        return 0;
+    }
+    for (int i = 0; i < capacity; i++) values[i] = -1;
+
+    TaskMap old = *map;
+    map->keys = keys;
+    map->values = values;
+    map->capacity = capacity;
+    for (int i = 0; i < old.capacity; i++) {
+        if (old.values[i] < 0) continue;
+        int slot = map_slot(map, old.keys[i]);
+        map->keys[slot] = old.keys[i];
+        map->values[slot] = old.values[i];
+    }
+    free(old.keys);
+    free(old.values);
+    return 1;
+}
+
+/* ============================================================================
+ * FUNÇÕES PÚBLICAS
+ * ============================================================================ */
+
+void task_map_init(TaskMap* map) {
+    memset(map, 0, sizeof(TaskMap));
+}
+
+int task_map_reset(TaskMap* map, int expected) {
+    int capacity = TASK_MAP_MIN_CAPACITY;
+    while (capacity < 2 * expected) capacity *= 2;
+
+    map->count = 0;
+    if (capacity > map->capacity) {
+        free(map->keys);
+        free(map->values);
+        map->keys = NULL;
+        map->values = NULL;
+        map->capacity = 0;
+        return map_rehash(map, capacity);
+    }
+    for (int i = 0; i < map->capacity; i++) map->values[i] = -1;
+    return 1;
+}
+
+int task_map_put(TaskMap* map, int id, int value) {
+    if (2 * (map->count + 1) > map->capacity) {
+        int capacity = (map->capacity > 0) ? map->capacity * 2 : TASK_MAP_MIN_CAPACITY;
+        if (!map_rehash(map, capacity)) return -1;
+    }
+
+    int slot = map_slot(map, id);
+    if (map->values[slot] >= 0) return map->values[slot];
+
+    map->keys[slot] = id;
+    map->values[slot] = value;
+    map->count++;
+    return value;
+}
+
+int task_map_get(const TaskMap* map, int id) {
+    if (map->capacity == 0) return -1;
+    return map->values[map_slot(map, id)];
+}
+
+void task_map_free(TaskMap* map) {
+    free(map->keys);
+    free(map->values);
+    memset(map, 0, sizeof(TaskMap));
+}
@@ -0,0 +1,39 @@
+/*
+ * task_map.h - Mapa de ids de tarefa para posições
+ *
+ * Os ids vêm do arquivo de configuração e podem ser quaisquer números
+ * (PIDs de um trace real, por exemplo), então não servem como índice de
+ * linha do Gantt. O mapa é uma tabela hash de endereçamento aberto
+ * (sondagem linear, carga até 1/2) que associa cada id a uma posição,
+ * com busca em tempo constante esperado. É montado uma vez por
+ * configuração; os ticks da simulação não fazem buscas.
+ */
+
+#ifndef TASK_MAP_H
+#define TASK_MAP_H
+
+typedef struct {
+    int* keys;                  /* Ids */
+    int* values;                /* Posição de cada id (-1 = livre) */
+    int capacity;               /* Posições da tabela (potência de 2) */
+    int count;                  /* Ids guardados */
+} TaskMap;
+
+/* Prepara um mapa vazio */
+void task_map_init(TaskMap* map);
+
+/* Esvazia o mapa e reserva espaço para expected ids
+ * (retorna 0 se faltar memória) */
+int task_map_reset(TaskMap* map, int expected);
+
+/* Associa id à posição value (>= 0). Um id repetido mantém a primeira
+ * posição. Retorna a posição associada ao id, ou -1 se faltar memória. */
+int task_map_put(TaskMap* map, int id, int value);
+
+/* Posição associada ao id (-1 se o id não existe) */
+int task_map_get(const TaskMap* map, int id);
+
+/* Libera a memória do mapa */
+void task_map_free(TaskMap* map);
+
+#endif /* TASK_MAP_H */
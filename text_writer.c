@@ -0,0 +1,128 @@
+/*
+ * text_writer.c - Escrita bufferizada de arquivos texto
+ * -----------------------------------------------------
+ * O buffer é esvaziado com um único fwrite quando a próxima escrita não
+ * cabe; escritas maiores que o buffer vão direto para o arquivo.
+ *
+ * NOTA: Todas as funções auxiliares são marcadas como 'static'
+ * para evitar conflitos com outros módulos.
+ */
+
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+#include "text_writer.h"
+
+/* ============================================================================
+ * FUNÇÕES AUXILIARES (STATIC - locais ao arquivo)
+ * ============================================================================ */
+
+static void tw_flush(TextWriter* w) {
+    if (w->len > 0 && fwrite(w->buffer, 1, w->len, w->f) != w->len) {
+        w->error = 1;
+    }
+    w->len = 0;
+}
+
+/* ============================================================================
+ * FUNÇÕES PÚBLICAS
+ * ============================================================================ */
+
+int tw_open(TextWriter* w, const char* filename) {
+    memset(w, 0, sizeof(TextWriter));
+    w->buffer = malloc(TEXT_WRITER_BUFFER);
+    if (!w->buffer) return 0;
+
+    w->f = fopen(filename, "w");
+    if (!w->f) {
+        free(w->buffer);
+        w->buffer = NULL;
+        return 0;
+    }
+    w->owns_file = 1;
+    return 1;
+}
+
+int tw_attach(TextWriter* w, FILE* f) {
+    memset(w, 0, sizeof(TextWriter));
+    w->buffer = malloc(TEXT_WRITER_BUFFER);
+    if (!w->buffer) return 0;
+
+    w->f = f;
+    return 1;
+}
+
+int tw_close(TextWriter* w) {
+    tw_flush(w);
+    if ((w->owns_file ? fclose(w->f) : fflush(w->f)) != 0) w->error = 1;
+    free(w->buffer);
+
+    int ok = !w->error;
+    memset(w, 0, sizeof(TextWriter));
+    return ok;
+}
+
+void tw_write(TextWriter* w, const char* data, size_t size) {
+    if (w->len + size > TEXT_WRITER_BUFFER) {
+        tw_flush(w);
+        if (size > TEXT_WRITER_BUFFER) {
+            if (fwrite(data, 1, size, w->f) != size) w->error = 1;
+            return;
+        }
+    }
+    memcpy(w->buffer + w->len, data, size);
+    w->len += size;
+}
+
+void tw_puts(TextWriter* w, const char* s) {
+    tw_write(w, s, strlen(s));
+}
+
+void tw_putc(TextWriter* w, char c) {
+    if (w->len == TEXT_WRITER_BUFFER) tw_flush(w);
+    w->buffer[w->len++] = c;
+}
+
+void tw_int(TextWriter* w, long long value) {
+    char digits[24];
+    int n = sizeof(digits);
+    unsigned long long v = (value < 0) ? 0ULL - (unsigned long long)value
+                                       : (unsigned long long)value;
+
+    do {
+        digits[--n] = (char)('0' + v % 10);
+        v /= 10;
+    } while (v > 0);
+    if (value < 0) digits[--n] = '-';
+
+    tw_write(w, digits + n, sizeof(digits) - n);
+}
+
+void tw_printf(TextWriter* w, const char* format, ...) {
+    char small[256];
+    va_list args;
+
+    va_start(args, format);
+    int n = vsnprintf(small, sizeof(small), format, args);
+    va_end(args);
+    if (n < 0) {
+        w->error = 1;
+        return;
+    }
+    if ((size_t)n < sizeof(small)) {
+        tw_write(w, small, n);
+        return;
+    }
+
+    /* Texto longo: formatar de novo em um buffer do tamanho certo */
+    char* big = malloc((size_t)n + 1);
+    if (!big) {
+        w->error = 1;
+        return;
+    }
+    va_start(args, format);
+    vsnprintf(big, (size_t)n + 1, format, args);
+    va_end(args);
+    tw_write(w, big, n);
+    free(big);
+}
@@ -0,0 +1,50 @@
+/*
+ * text_writer.h - Escrita bufferizada de arquivos texto
+ *
+ * Junta as pequenas escritas dos exportadores (um caractere, um número,
+ * um elemento SVG) em um buffer e só chama fwrite quando ele enche, em vez
+ * de um fprintf por item. Números inteiros são formatados sem printf.
+ */
+
+#ifndef TEXT_WRITER_H
+#define TEXT_WRITER_H
+
+#include <stdio.h>
+#include <stddef.h>
+
+#define TEXT_WRITER_BUFFER  65536
+
+typedef struct {
+    FILE* f;
+    char* buffer;           /* Dados ainda não gravados */
+    size_t len;             /* Bytes em uso no buffer */
+    int error;              /* Alguma escrita falhou */
+    int owns_file;          /* 1 = arquivo aberto por tw_open */
+} TextWriter;
+
+/* Cria o arquivo (retorna 0 se não foi possível criar ou alocar) */
+int tw_open(TextWriter* w, const char* filename);
+
+/* Escreve em um arquivo já aberto, como stdout (retorna 0 se faltar memória) */
+int tw_attach(TextWriter* w, FILE* f);
+
+/* Grava o que falta e fecha o arquivo; arquivos de tw_attach só recebem
+ * fflush (retorna 0 se houve erro) */
+int tw_close(TextWriter* w);
+
+/* Acrescenta size bytes */
+void tw_write(TextWriter* w, const char* data, size_t size);
+
+/* Acrescenta uma string terminada em '\0' */
+void tw_puts(TextWriter* w, const char* s);
+
+/* Acrescenta um caractere */
+void tw_putc(TextWriter* w, char c);
+
+/* Acrescenta um inteiro em decimal */
+void tw_int(TextWriter* w, long long value);
+
+/* Acrescenta texto formatado (como fprintf) */
+void tw_printf(TextWriter* w, const char* format, ...);
+
+#endif /* TEXT_WRITER_H */
@@ -0,0 +1,108 @@
+/*
+ * ticket_tree.c - Árvore de Fenwick (BIT) de bilhetes por tarefa
+ * ---------------------------------------------------------------
+ * Estrutura usada pelo escalonador LOTTERY: cada sorteio percorre a árvore
+ * de cima para baixo em vez de somar os bilhetes de todas as tarefas.
+ *
+ * NOTA: Todas as funções auxiliares são marcadas como 'static'
+ * para evitar conflitos com outros módulos.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "ticket_tree.h"
+
+/* ============================================================================
+ * FUNÇÕES AUXILIARES (STATIC - locais ao arquivo)
+ * ============================================================================ */
+
+/**
+ * Soma delta na posição idx (base 0) e em todos os nós que a cobrem
+ */
+static void tree_add(TicketTree* t, int idx, long long delta) {
+    for (int i = idx + 1; i <= t->capacity; i += i & -i) {
+        t->tree[i] += delta;
+    }
+}
+
+/* ============================================================================
+ * FUNÇÕES PÚBLICAS
+ * ============================================================================ */
+
+void ticket_tree_init(TicketTree* t, int capacity) {
+    memset(t, 0, sizeof(TicketTree));
+    ticket_tree_reserve(t, capacity);
+}
+
+void ticket_tree_free(TicketTree* t) {
+    free(t->tree);
+    free(t->values);
+    memset(t, 0, sizeof(TicketTree));
+}
+
+void ticket_tree_reserve(TicketTree* t, int capacity) {
+    if (capacity <= t->capacity) return;
+
+    int new_capacity = (t->capacity > 0) ? t->capacity : 16;
+    while (new_capacity < capacity) new_capacity *= 2;
+
+    t->values = realloc(t->values, new_capacity * sizeof(int));
+    for (int i = t->capacity; i < new_capacity; i++) {
+        t->values[i] = 0;
+    }
+
+    /* As somas parciais dependem do tamanho: reconstruir em O(n) */
+    free(t->tree);
+    t->tree = calloc(new_capacity + 1, sizeof(long long));
+    t->capacity = new_capacity;
+
+    for (int i = 1; i <= new_capacity; i++) {
+        t->tree[i] += t->values[i - 1];
+        int parent = i + (i & -i);
+        if (parent <= new_capacity) t->tree[parent] += t->tree[i];
+    }
+}
+
+void ticket_tree_clear(TicketTree* t) {
+    if (t->capacity == 0) return;
+    memset(t->tree, 0, (t->capacity + 1) * sizeof(long long));
+    memset(t->values, 0, t->capacity * sizeof(int));
+    t->total = 0;
+}
+
+void ticket_tree_set(TicketTree* t, int idx, int tickets) {
+    if (idx < 0) return;
+    if (tickets < 0) tickets = 0;
+    ticket_tree_reserve(t, idx + 1);
+
+    long long delta = (long long)tickets - t->values[idx];
+    if (delta == 0) return;
+
+    t->values[idx] = tickets;
+    t->total += delta;
+    tree_add(t, idx, delta);
+}
+
+int ticket_tree_get(const TicketTree* t, int idx) {
+    return (idx >= 0 && idx < t->capacity) ? t->values[idx] : 0;
+}
+
+int ticket_tree_find(const TicketTree* t, long long ticket) {
+    if (ticket < 0 || ticket >= t->total) return -1;
+
+    /* Descida binária: maior prefixo com soma <= ticket */
+    int pos = 0;
+    int step = 1;
+    while (step * 2 <= t->capacity) step *= 2;
+
+    for (; step > 0; step /= 2) {
+        int next = pos + step;
+        if (next <= t->capacity && t->tree[next] <= ticket) {
+            pos = next;
+            ticket -= t->tree[next];
+        }
+    }
+
+    /* pos é o número de índices cujo prefixo não alcança o bilhete */
+    return pos;
+}
@@ -0,0 +1,41 @@
+/*
+ * ticket_tree.h - Árvore de Fenwick (BIT) de bilhetes por tarefa
+ *
+ * Guarda o número de bilhetes de cada índice de tarefa e mantém as somas
+ * de prefixo, permitindo alterar os bilhetes de uma tarefa e sortear o
+ * vencedor de uma loteria em O(log n). Índices sem bilhetes (tarefas que
+ * não estão prontas) simplesmente valem zero.
+ */
+
+#ifndef TICKET_TREE_H
+#define TICKET_TREE_H
+
+typedef struct {
+    long long* tree;    /* Somas parciais da árvore de Fenwick (base 1) */
+    int* values;        /* Bilhetes atuais de cada índice */
+    int capacity;       /* Maior índice suportado + 1 */
+    long long total;    /* Soma de todos os bilhetes */
+} TicketTree;
+
+/* Inicializa uma árvore vazia capaz de guardar índices em [0, capacity) */
+void ticket_tree_init(TicketTree* t, int capacity);
+
+/* Libera a memória da árvore */
+void ticket_tree_free(TicketTree* t);
+
+/* Garante espaço para índices em [0, capacity) */
+void ticket_tree_reserve(TicketTree* t, int capacity);
+
+/* Zera todos os bilhetes mantendo a memória alocada */
+void ticket_tree_clear(TicketTree* t);
+
+/* Define os bilhetes de um índice (0 remove o índice do sorteio) */
+void ticket_tree_set(TicketTree* t, int idx, int tickets);
+
+/* Retorna os bilhetes atuais de um índice (0 se ausente) */
+int ticket_tree_get(const TicketTree* t, int idx);
+
+/* Retorna o índice dono do bilhete 'ticket' em [0, total) (-1 se vazio) */
+int ticket_tree_find(const TicketTree* t, long long ticket);
+
+#endif /* TICKET_TREE_H */